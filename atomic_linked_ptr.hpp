@@ -0,0 +1,137 @@
+#include <utility>
+
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_ATOMIC_LINKED_PTR_HPP
+#define _SMART_PTR_ATOMIC_LINKED_PTR_HPP
+
+#ifndef SMART_PTR_LINKED_PTR_MT
+#error "atomic_linked_ptr needs SMART_PTR_LINKED_PTR_MT defined for the whole program"
+#endif
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    // Slot holding a linked_ptr that threads may load, store, exchange and
+    // compare-exchange concurrently. The slot is a member of the ring of its
+    // object: load() links the copy right after it and exchange() hands its
+    // ring position over, each under the node locks of the few nodes
+    // touched. Copies are dropped against their neighbours only, so there
+    // is no single count every reader writes to.
+    template<typename Type, typename Deleter>
+    class atomic_linked_ptr {
+        using pointer = linked_ptr<Type, Deleter>;
+        using Lock = details::Connector::Lock;
+
+        mutable pointer _slot;
+
+        static details::Connector &node(const pointer &l_ptr) noexcept {
+            return l_ptr.connector();
+        }
+
+        // Links the empty `to` right after `from`; needs `from`, its right
+        // neighbour and `to` locked
+        static void share(pointer &to, const pointer &from) {
+            if (!from._ptr)
+                return;
+            to._ptr = from._ptr;
+            to.deleter() = from.deleter();
+            to.set_extent(from.extent());
+            node(to).link_after(node(from));
+        }
+
+        // Moves `from` into the empty `to`, ring position included; needs
+        // `from`, its neighbours and `to` locked
+        static void transfer(pointer &to, pointer &from) noexcept {
+            node(to).take_over(node(from));
+            to._ptr = std::exchange(from._ptr, nullptr);
+            to.deleter() = std::move(from.deleter());
+            to.set_extent(from.extent());
+            from.set_extent(0);
+        }
+
+        // Locks what exchanging `desired` in needs, plus `spare` (an empty
+        // handle to receive the old value or a copy of it)
+        void lock_exchange(Lock &lock, pointer &desired, pointer &spare) const noexcept {
+            details::Connector &slot = node(_slot), &in = node(desired);
+            while (!(lock.add(&slot) && lock.add(slot.left()) && lock.add(slot.right()) &&
+                     lock.add(&in) && lock.add(in.left()) && lock.add(in.right()) && lock.add(&node(spare))))
+                lock.back_off();
+        }
+
+    public:
+        constexpr atomic_linked_ptr() noexcept = default;
+
+        atomic_linked_ptr(pointer desired) noexcept : _slot(std::move(desired)) {}
+
+        atomic_linked_ptr(const atomic_linked_ptr &) = delete;
+
+        atomic_linked_ptr &operator=(const atomic_linked_ptr &) = delete;
+
+        pointer load() const noexcept {
+            pointer l_ptr;
+            {
+                details::Connector &slot = node(_slot);
+                Lock lock;
+                while (!(lock.add(&slot) && lock.add(slot.right()) && lock.add(&node(l_ptr))))
+                    lock.back_off();
+                share(l_ptr, _slot);
+            }
+            return l_ptr;
+        }
+
+        operator pointer() const noexcept {
+            return load();
+        }
+
+        // The old object, if this was its last owner, is released after
+        // the locks are dropped
+        void store(pointer desired) noexcept {
+            exchange(std::move(desired));
+        }
+
+        atomic_linked_ptr &operator=(pointer desired) noexcept {
+            store(std::move(desired));
+            return *this;
+        }
+
+        pointer exchange(pointer desired) noexcept {
+            pointer old;
+            {
+                Lock lock;
+                lock_exchange(lock, desired, old);
+                transfer(old, _slot);
+                transfer(_slot, desired);
+            }
+            return old;
+        }
+
+        // Stores `desired` if the slot points where `expected` does;
+        // otherwise loads the slot into `expected`
+        bool compare_exchange_strong(pointer &expected, pointer desired) noexcept {
+            pointer spare;
+            bool exchanged;
+            {
+                Lock lock;
+                lock_exchange(lock, desired, spare);
+                exchanged = (_slot._ptr == expected._ptr);
+                if (exchanged) {
+                    transfer(spare, _slot);
+                    transfer(_slot, desired);
+                } else {
+                    share(spare, _slot);
+                }
+            }
+            if (!exchanged)
+                expected = std::move(spare);
+            return exchanged;
+        }
+
+        bool compare_exchange_weak(pointer &expected, pointer desired) noexcept {
+            return compare_exchange_strong(expected, std::move(desired));
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_ATOMIC_LINKED_PTR_HPP
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "linked_ptr.hpp"
+
+// Microbenchmarks of linked_ptr against std::shared_ptr and std::unique_ptr
+// equivalents. Prints a JSON array of {operation, pointer, ring, ns_per_op}
+// records, the best of several runs each; `ring` is the number of owners
+// sharing the object where that matters, null otherwise. unique_ptr has no
+// rings, so it only appears where ownership is not shared.
+
+using bench_clock = std::chrono::steady_clock;
+
+struct Base
+{
+    int value = 0;
+
+    virtual ~Base() = default;
+};
+
+struct Derived : Base
+{
+};
+
+struct linked_family
+{
+    template<typename Type>
+    using ptr = smart_ptr::linked_ptr<Type>;
+
+    static constexpr const char *name = "linked_ptr";
+};
+
+struct shared_family
+{
+    template<typename Type>
+    using ptr = std::shared_ptr<Type>;
+
+    static constexpr const char *name = "shared_ptr";
+};
+
+struct unique_family
+{
+    template<typename Type>
+    using ptr = std::unique_ptr<Type>;
+
+    static constexpr const char *name = "unique_ptr";
+};
+
+static void escape(const void *ptr)
+{
+    asm volatile("" : : "g"(ptr) : "memory");
+}
+
+struct Result
+{
+    std::string operation;
+    const char *pointer;
+    long ring;
+    double ns_per_op;
+};
+
+static std::vector<Result> results;
+
+// Best of five runs; `run` returns the nanoseconds spent in its timed part
+template<typename Run>
+static void measure(const std::string &operation, const char *pointer, long ring, std::size_t ops, Run run)
+{
+    double best = 0;
+    for (int round = 0; round < 5; ++round)
+    {
+        double ns = run();
+        if (!round || ns < best)
+            best = ns;
+    }
+    results.push_back({operation, pointer, ring, best / ops});
+}
+
+class Timer
+{
+    bench_clock::time_point _start = bench_clock::now();
+
+public:
+    double ns() const
+    {
+        return std::chrono::duration<double, std::nano>(bench_clock::now() - _start).count();
+    }
+};
+
+// Raw storage for `count` handles, constructed and destroyed by hand
+template<typename Ptr>
+class Slots
+{
+    Ptr *_slots;
+
+public:
+    explicit Slots(std::size_t count) : _slots(static_cast<Ptr *>(::operator new(count * sizeof(Ptr)))) {}
+
+    ~Slots()
+    {
+        ::operator delete(_slots);
+    }
+
+    Ptr &operator[](std::size_t i)
+    {
+        return _slots[i];
+    }
+
+    template<typename... Args>
+    void construct(std::size_t i, Args &&... args)
+    {
+        ::new (static_cast<void *>(_slots + i)) Ptr(std::forward<Args>(args)...);
+    }
+
+    void destroy(std::size_t i)
+    {
+        _slots[i].~Ptr();
+    }
+};
+
+static const std::size_t batch = 4096;
+static const long ring_sizes[] = {1, 2, 16, 10000};
+
+template<typename Family>
+static void construction()
+{
+    using ptr = typename Family::template ptr<Base>;
+    Slots<ptr> slots(batch);
+
+    measure("construct_null", Family::name, -1, batch, [&] {
+        Timer timer;
+        for (std::size_t i = 0; i < batch; ++i)
+            slots.construct(i);
+        double ns = timer.ns();
+        for (std::size_t i = 0; i < batch; ++i)
+            slots.destroy(i);
+        return ns;
+    });
+
+    measure("construct_owning", Family::name, -1, batch, [&] {
+        Timer timer;
+        for (std::size_t i = 0; i < batch; ++i)
+            slots.construct(i, new Base);
+        double ns = timer.ns();
+        for (std::size_t i = 0; i < batch; ++i)
+            slots.destroy(i);
+        return ns;
+    });
+}
+
+// Copies of one member of a ring of `ring` owners (batched, destroyed untimed)
+template<typename Family, typename Target>
+static void copy_into(const char *operation, long ring)
+{
+    using ptr = typename Family::template ptr<Derived>;
+    using target = typename Family::template ptr<Target>;
+
+    std::vector<ptr> members(ring, ptr(new Derived));
+    Slots<target> slots(batch);
+
+    measure(operation, Family::name, ring, batch, [&] {
+        Timer timer;
+        for (std::size_t i = 0; i < batch; ++i)
+            slots.construct(i, members[0]);
+        double ns = timer.ns();
+        for (std::size_t i = 0; i < batch; ++i)
+            slots.destroy(i);
+        return ns;
+    });
+}
+
+// Destruction of rings of `ring` owners, each built as a chain of copies
+// (so index order is ring order), in that order or shuffled
+template<typename Family>
+static void destruction(long ring)
+{
+    using ptr = typename Family::template ptr<Base>;
+
+    const std::size_t rings = ring < long(batch) ? batch / ring : 1;
+    const std::size_t count = rings * ring;
+    Slots<ptr> slots(count);
+
+    std::vector<std::size_t> order(count);
+    for (std::size_t i = 0; i < count; ++i)
+        order[i] = i;
+    std::vector<std::size_t> shuffled = order;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+
+    for (const auto *sequence : {&order, &shuffled})
+    {
+        measure(sequence == &order ? "destroy_ring_order" : "destroy_random_order", Family::name, ring, count, [&] {
+            for (std::size_t r = 0; r < rings; ++r)
+            {
+                slots.construct(r * ring, new Base);
+                for (long i = 1; i < ring; ++i)
+                    slots.construct(r * ring + i, slots[r * ring + i - 1]);
+            }
+            Timer timer;
+            for (std::size_t i : *sequence)
+                slots.destroy(i);
+            return timer.ns();
+        });
+    }
+}
+
+template<typename Family>
+static void reset()
+{
+    using ptr = typename Family::template ptr<Base>;
+    ptr owner(new Base);
+
+    measure("reset_owning", Family::name, -1, batch, [&] {
+        Timer timer;
+        for (std::size_t i = 0; i < batch; ++i)
+            owner.reset(new Base);
+        return timer.ns();
+    });
+}
+
+// Swaps within a ring of 16 members: neighbours, or members half a ring
+// apart; unique_ptr swaps two distinct owners either way
+template<typename Family>
+static void swap_members(long ring)
+{
+    using ptr = typename Family::template ptr<Base>;
+
+    std::vector<ptr> members;
+    members.reserve(ring);
+    members.emplace_back(new Base);
+    for (long i = 1; i < ring; ++i)
+    {
+        if constexpr (std::is_copy_constructible_v<ptr>)
+            members.push_back(members.back());
+        else
+            members.emplace_back(new Base);
+    }
+
+    for (long distance : {1L, ring / 2})
+    {
+        measure(distance == 1 ? "swap_adjacent" : "swap_distant", Family::name,
+                std::is_copy_constructible_v<ptr> ? ring : -1, batch, [&] {
+            Timer timer;
+            for (std::size_t i = 0; i < batch; ++i)
+            {
+                std::size_t a = i % ring;
+                members[a].swap(members[(a + distance) % ring]);
+            }
+            escape(members.data());
+            return timer.ns();
+        });
+    }
+}
+
+template<typename Family>
+static void compare()
+{
+    using ptr = typename Family::template ptr<Base>;
+
+    std::vector<ptr> owners;
+    for (std::size_t i = 0; i < 64; ++i)
+        owners.emplace_back(new Base);
+
+    measure("compare_eq_less", Family::name, -1, batch, [&] {
+        std::size_t hits = 0;
+        Timer timer;
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            const ptr &a = owners[i % 64], &b = owners[(i * 7) % 64];
+            hits += (a == b) + (a < b);
+        }
+        double ns = timer.ns();
+        escape(&hits);
+        return ns;
+    });
+}
+
+// std::set insertion, as in less_check; copies of existing owners for the
+// shared pointers, moved-in fresh owners for unique_ptr
+template<typename Family>
+static void set_insert()
+{
+    using ptr = typename Family::template ptr<int>;
+    const std::size_t count = 1024;
+
+    std::vector<ptr> owners;
+    for (std::size_t i = 0; i < count; ++i)
+        owners.emplace_back(new int(static_cast<int>(i)));
+    std::shuffle(owners.begin(), owners.end(), std::mt19937(7));
+
+    measure("set_insert", Family::name, -1, count, [&] {
+        std::set<ptr> pointers;
+        Timer timer;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if constexpr (std::is_copy_constructible_v<ptr>)
+                pointers.insert(owners[i]);
+            else
+                pointers.insert(ptr(new int(static_cast<int>(i))));
+        }
+        double ns = timer.ns();
+        escape(&pointers);
+        return ns;
+    });
+}
+
+template<typename Family>
+static void shared_ownership()
+{
+    for (long ring : ring_sizes)
+    {
+        copy_into<Family, Derived>("copy", ring);
+        copy_into<Family, Base>("converting_copy", ring);
+        destruction<Family>(ring);
+    }
+}
+
+template<typename Family>
+static void all_families_ops()
+{
+    construction<Family>();
+    reset<Family>();
+    swap_members<Family>(16);
+    compare<Family>();
+    set_insert<Family>();
+}
+
+int main()
+{
+    shared_ownership<linked_family>();
+    shared_ownership<shared_family>();
+    all_families_ops<linked_family>();
+    all_families_ops<shared_family>();
+    all_families_ops<unique_family>();
+
+    std::printf("[\n");
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &r = results[i];
+        std::printf("  {\"operation\": \"%s\", \"pointer\": \"%s\", \"ring\": ", r.operation.c_str(), r.pointer);
+        if (r.ring < 0)
+            std::printf("null");
+        else
+            std::printf("%ld", r.ring);
+        std::printf(", \"ns_per_op\": %.3f}%s\n", r.ns_per_op, i + 1 < results.size() ? "," : "");
+    }
+    std::printf("]\n");
+}
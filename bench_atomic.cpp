@@ -0,0 +1,106 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "atomic_linked_ptr.hpp"
+
+using bench_clock = std::chrono::steady_clock;
+
+// Shared slot of std::shared_ptr: std::atomic<std::shared_ptr> when the
+// library has it, the atomic free functions otherwise
+template<typename Type>
+class shared_slot
+{
+#ifdef __cpp_lib_atomic_shared_ptr
+    std::atomic<std::shared_ptr<Type>> _slot;
+
+public:
+    explicit shared_slot(std::shared_ptr<Type> ptr) : _slot(std::move(ptr)) {}
+
+    std::shared_ptr<Type> load() const
+    {
+        return _slot.load();
+    }
+
+    void store(std::shared_ptr<Type> ptr)
+    {
+        _slot.store(std::move(ptr));
+    }
+#else
+    std::shared_ptr<Type> _slot;
+
+public:
+    explicit shared_slot(std::shared_ptr<Type> ptr) : _slot(std::move(ptr)) {}
+
+    std::shared_ptr<Type> load() const
+    {
+        return std::atomic_load(&_slot);
+    }
+
+    void store(std::shared_ptr<Type> ptr)
+    {
+        std::atomic_store(&_slot, std::move(ptr));
+    }
+#endif
+};
+
+// Million operations per second over `threads` threads, each loading the
+// slot and reading through the copy, storing its own object every 16th time
+template<typename Slot, typename Ptr>
+static double throughput(std::size_t threads, Ptr (*make)(int))
+{
+    const std::size_t ops = 1 << 15;
+    Slot slot(make(0));
+    std::atomic<bool> go{false};
+    std::atomic<long> sink{0};
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t] {
+            Ptr mine = make(static_cast<int>(t));
+            long sum = 0;
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            for (std::size_t i = 0; i < ops; ++i)
+            {
+                Ptr current = slot.load();
+                sum += *current;
+                if (i % 16 == 0)
+                    slot.store(mine);
+            }
+            sink += sum;
+        });
+    }
+
+    auto start = bench_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+    return threads * ops / seconds / 1e6;
+}
+
+static smart_ptr::linked_ptr<int> make_linked(int value)
+{
+    return smart_ptr::linked_ptr<int>(new int(value));
+}
+
+static std::shared_ptr<int> make_shared(int value)
+{
+    return std::make_shared<int>(value);
+}
+
+int main()
+{
+    std::printf("%8s %16s %16s\n", "threads", "atomic_linked", "atomic_shared");
+    for (std::size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        double linked = throughput<smart_ptr::atomic_linked_ptr<int>>(threads, &make_linked);
+        double shared = throughput<shared_slot<int>>(threads, &make_shared);
+        std::printf("%8zu %11.2fMop/s %11.2fMop/s\n", threads, linked, shared);
+    }
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "linked_ptr_bulk.hpp"
+
+using smart_ptr::linked_ptr;
+using bench_clock = std::chrono::steady_clock;
+
+template<typename Func>
+static double measure(const char *name, Func func)
+{
+    const int rounds = 20;
+    func();
+
+    auto start = bench_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        func();
+    double ns = std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / rounds;
+
+    std::printf("%-24s %12.0f ns\n", name, ns);
+    return ns;
+}
+
+int main()
+{
+    const std::size_t n = 1 << 20;
+    std::vector<linked_ptr<int>> ptrs(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i % 4 == 1)
+            ptrs[i].reset(new int(static_cast<int>(i)));
+        else if (i % 4 == 2)
+            ptrs[i] = ptrs[i - 1];
+    }
+
+    std::vector<std::uint64_t> mask((n + 63) / 64);
+    std::vector<int *> raw(n);
+    const int *key = ptrs[n / 2 + 1].get();
+    volatile std::size_t sink = 0;
+
+#if defined(__AVX2__)
+    std::printf("kernels: AVX2\n");
+#elif defined(__SSE2__)
+    std::printf("kernels: SSE2\n");
+#else
+    std::printf("kernels: scalar\n");
+#endif
+
+    measure("loop null", [&] {
+        std::size_t c = 0;
+        for (const auto &p : ptrs)
+            c += !p;
+        sink = c;
+    });
+    measure("bulk null_mask", [&] {
+        smart_ptr::bulk::null_mask(ptrs.data(), n, mask.data());
+        sink = smart_ptr::bulk::popcount(mask.data(), n);
+    });
+
+    measure("loop unique", [&] {
+        std::size_t c = 0;
+        for (const auto &p : ptrs)
+            c += p.unique();
+        sink = c;
+    });
+    measure("bulk unique_mask", [&] {
+        smart_ptr::bulk::unique_mask(ptrs.data(), n, mask.data());
+        sink = smart_ptr::bulk::popcount(mask.data(), n);
+    });
+
+    measure("loop equal", [&] {
+        std::size_t c = 0;
+        for (const auto &p : ptrs)
+            c += p.get() == key;
+        sink = c;
+    });
+    measure("bulk equal_mask", [&] {
+        smart_ptr::bulk::equal_mask(ptrs.data(), n, key, mask.data());
+        sink = smart_ptr::bulk::popcount(mask.data(), n);
+    });
+
+    measure("loop less", [&] {
+        std::size_t c = 0;
+        for (const auto &p : ptrs)
+            c += p.get() < key;
+        sink = c;
+    });
+    measure("bulk less_mask", [&] {
+        smart_ptr::bulk::less_mask(ptrs.data(), n, key, mask.data());
+        sink = smart_ptr::bulk::popcount(mask.data(), n);
+    });
+
+    measure("loop get", [&] {
+        for (std::size_t i = 0; i < n; ++i)
+            raw[i] = ptrs[i].get();
+        sink = raw[n - 1] != nullptr;
+    });
+    measure("bulk gather", [&] {
+        smart_ptr::bulk::gather(ptrs.data(), n, raw.data());
+        sink = raw[n - 1] != nullptr;
+    });
+
+    (void)sink;
+}
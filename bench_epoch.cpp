@@ -0,0 +1,186 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "linked_epoch.hpp"
+
+using bench_clock = std::chrono::steady_clock;
+
+static const int list_length = 64;
+static const auto run_time = std::chrono::milliseconds(200);
+
+// List of linked_ptr owned nodes retired through an epoch domain; readers
+// follow raw links inside a pinned section
+struct EpochNode
+{
+    int key;
+    std::atomic<EpochNode *> next_raw{nullptr};
+    smart_ptr::linked_ptr<EpochNode, smart_ptr::epoch_delete> next;
+
+    explicit EpochNode(int key) : key(key) {}
+};
+
+struct EpochList
+{
+    smart_ptr::epoch_domain domain;
+    EpochNode head{0};
+
+    EpochList()
+    {
+        EpochNode *tail = &head;
+        for (int key = 1; key <= list_length; ++key)
+        {
+            tail->next = smart_ptr::linked_ptr<EpochNode, smart_ptr::epoch_delete>(
+                    new EpochNode(key), smart_ptr::epoch_delete(domain));
+            tail->next_raw.store(tail->next.get(), std::memory_order_release);
+            tail = tail->next.get();
+        }
+    }
+
+    ~EpochList()
+    {
+        head.next.reset();
+    }
+
+    void replace(int position)
+    {
+        EpochNode *prev = &head;
+        for (int i = position; i > 0; --i)
+            prev = prev->next.get();
+        EpochNode *old = prev->next.get();
+
+        smart_ptr::linked_ptr<EpochNode, smart_ptr::epoch_delete> fresh(
+                new EpochNode(old->key), smart_ptr::epoch_delete(domain));
+        fresh->next = old->next;
+        fresh->next_raw.store(old->next_raw.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        prev->next_raw.store(fresh.get(), std::memory_order_release);
+        prev->next = fresh;
+    }
+
+    struct reader
+    {
+        smart_ptr::epoch_domain::reader registration;
+
+        explicit reader(EpochList &list) : registration(list.domain) {}
+
+        long walk(EpochList &list)
+        {
+            smart_ptr::epoch_guard guard = registration.pin();
+            long sum = 0;
+            for (EpochNode *node = list.head.next_raw.load(std::memory_order_acquire); node;
+                 node = node->next_raw.load(std::memory_order_acquire))
+                sum += node->key;
+            return sum;
+        }
+    };
+};
+
+// Same list of std::shared_ptr nodes; readers take a reference per hop
+struct SharedNode
+{
+    int key;
+    std::shared_ptr<SharedNode> next;
+
+    explicit SharedNode(int key) : key(key) {}
+};
+
+struct SharedList
+{
+    std::shared_ptr<SharedNode> head = std::make_shared<SharedNode>(0);
+
+    SharedList()
+    {
+        SharedNode *tail = head.get();
+        for (int key = 1; key <= list_length; ++key)
+        {
+            tail->next = std::make_shared<SharedNode>(key);
+            tail = tail->next.get();
+        }
+    }
+
+    ~SharedList()
+    {
+        // Unlink iteratively rather than through a deep destructor chain
+        for (std::shared_ptr<SharedNode> node = std::move(head->next); node;)
+            node = std::move(node->next);
+    }
+
+    void replace(int position)
+    {
+        std::shared_ptr<SharedNode> prev = head;
+        for (int i = position; i > 0; --i)
+            prev = std::atomic_load(&prev->next);
+        std::shared_ptr<SharedNode> old = std::atomic_load(&prev->next);
+
+        std::shared_ptr<SharedNode> fresh = std::make_shared<SharedNode>(old->key);
+        fresh->next = std::atomic_load(&old->next);
+        std::atomic_store(&prev->next, std::move(fresh));
+    }
+
+    struct reader
+    {
+        explicit reader(SharedList &) {}
+
+        long walk(SharedList &list)
+        {
+            long sum = 0;
+            for (std::shared_ptr<SharedNode> node = std::atomic_load(&list.head->next); node;
+                 node = std::atomic_load(&node->next))
+                sum += node->key;
+            return sum;
+        }
+    };
+};
+
+// Million nodes visited per second by `readers` threads while one writer
+// keeps replacing nodes
+template<typename List>
+static double throughput(std::size_t readers)
+{
+    List list;
+    std::atomic<bool> done{false};
+    std::atomic<long> hops{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < readers; ++t)
+    {
+        threads.emplace_back([&] {
+            typename List::reader reader(list);
+            long walks = 0, sum = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                sum += reader.walk(list);
+                ++walks;
+            }
+            hops += walks * list_length + (sum == 42);
+        });
+    }
+
+    std::thread writer([&] {
+        for (int round = 0; !done.load(std::memory_order_relaxed); ++round)
+            list.replace(round % list_length);
+    });
+
+    auto start = bench_clock::now();
+    std::this_thread::sleep_for(run_time);
+    done = true;
+    for (auto &thread : threads)
+        thread.join();
+    writer.join();
+    double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+    return hops / seconds / 1e6;
+}
+
+int main()
+{
+    std::printf("%8s %16s %16s\n", "readers", "epoch", "shared_ptr");
+    for (std::size_t readers = 1; readers <= 8; readers *= 2)
+    {
+        double epoch = throughput<EpochList>(readers);
+        double shared = throughput<SharedList>(readers);
+        std::printf("%8zu %10.1fMhop/s %10.1fMhop/s\n", readers, epoch, shared);
+    }
+}
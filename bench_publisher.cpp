@@ -0,0 +1,139 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "atomic_linked_ptr.hpp"
+#include "linked_publisher.hpp"
+
+using bench_clock = std::chrono::steady_clock;
+
+static const auto run_time = std::chrono::milliseconds(200);
+static const auto publish_every = std::chrono::milliseconds(1);
+
+struct Config
+{
+    long value;
+};
+
+// Config read through linked_publisher snapshots
+struct PublishedConfig
+{
+    smart_ptr::epoch_domain domain;
+    smart_ptr::linked_publisher<Config> publisher{smart_ptr::linked_ptr<Config>(new Config{1}), domain};
+
+    struct reader
+    {
+        smart_ptr::epoch_domain::reader registration;
+
+        explicit reader(PublishedConfig &config) : registration(config.domain) {}
+
+        long read(PublishedConfig &config)
+        {
+            return config.publisher.read(registration)->value;
+        }
+    };
+
+    void publish(long value)
+    {
+        publisher.publish(smart_ptr::linked_ptr<Config>(new Config{value}));
+    }
+};
+
+// Config copied out of an atomic_linked_ptr on every read
+struct AtomicLinkedConfig
+{
+    smart_ptr::atomic_linked_ptr<Config> slot{smart_ptr::linked_ptr<Config>(new Config{1})};
+
+    struct reader
+    {
+        explicit reader(AtomicLinkedConfig &) {}
+
+        long read(AtomicLinkedConfig &config)
+        {
+            return config.slot.load()->value;
+        }
+    };
+
+    void publish(long value)
+    {
+        slot.store(smart_ptr::linked_ptr<Config>(new Config{value}));
+    }
+};
+
+// Config copied out of a std::shared_ptr with std::atomic_load on every read
+struct SharedConfig
+{
+    std::shared_ptr<Config> slot = std::make_shared<Config>(Config{1});
+
+    struct reader
+    {
+        explicit reader(SharedConfig &) {}
+
+        long read(SharedConfig &config)
+        {
+            return std::atomic_load(&config.slot)->value;
+        }
+    };
+
+    void publish(long value)
+    {
+        std::atomic_store(&slot, std::make_shared<Config>(Config{value}));
+    }
+};
+
+// Million reads per second over `readers` threads while a writer replaces
+// the config every millisecond
+template<typename Holder>
+static double throughput(std::size_t readers)
+{
+    Holder holder;
+    std::atomic<bool> done{false};
+    std::atomic<long> reads{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < readers; ++t)
+    {
+        threads.emplace_back([&] {
+            typename Holder::reader reader(holder);
+            long count = 0, sum = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                sum += reader.read(holder);
+                ++count;
+            }
+            reads += count + (sum == 42);
+        });
+    }
+
+    std::thread writer([&] {
+        for (long value = 2; !done.load(std::memory_order_relaxed); ++value)
+        {
+            holder.publish(value);
+            std::this_thread::sleep_for(publish_every);
+        }
+    });
+
+    auto start = bench_clock::now();
+    std::this_thread::sleep_for(run_time);
+    done = true;
+    for (auto &thread : threads)
+        thread.join();
+    writer.join();
+    double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+    return reads / seconds / 1e6;
+}
+
+int main()
+{
+    std::printf("%8s %16s %16s %16s\n", "readers", "publisher", "atomic_linked", "atomic_shared");
+    for (std::size_t readers = 1; readers <= 16; readers *= 2)
+    {
+        double published = throughput<PublishedConfig>(readers);
+        double linked = throughput<AtomicLinkedConfig>(readers);
+        double shared = throughput<SharedConfig>(readers);
+        std::printf("%8zu %11.1fMread/s %11.1fMread/s %11.1fMread/s\n", readers, published, linked, shared);
+    }
+}
@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "linked_ptr.hpp"
+
+using bench_clock = std::chrono::steady_clock;
+
+template<typename Func>
+static double per_op(std::size_t ops, Func func)
+{
+    auto start = bench_clock::now();
+    func();
+    return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / ops;
+}
+
+// Average cost of use_count() and of one copy + destroy for a ring of `size`
+template<typename Ptr>
+static void measure(std::size_t size, double &query, double &copy)
+{
+    const std::size_t ops = 1 << 16;
+    std::vector<Ptr> ring(size, Ptr(new int(0)));
+    volatile std::size_t sink = 0;
+
+    for (std::size_t i = 0; i < ops; ++i)
+        sink = sink + ring[i % size].use_count();
+    query = per_op(ops, [&] {
+        for (std::size_t i = 0; i < ops; ++i)
+            sink = sink + ring[i % size].use_count();
+    });
+    copy = per_op(ops, [&] {
+        for (std::size_t i = 0; i < ops; ++i)
+        {
+            Ptr tmp(ring[i % size]);
+            sink = sink + (tmp.get() != nullptr);
+        }
+    });
+}
+
+int main()
+{
+    std::printf("%8s %14s %14s %14s %14s\n", "ring", "linked query", "shared query", "linked copy", "shared copy");
+
+    // linked_ptr keeps no count, so its use_count() walks the ring
+    for (std::size_t size = 1; size <= 4096; size *= 2)
+    {
+        double linked_query, shared_query, linked_copy, shared_copy;
+        measure<smart_ptr::linked_ptr<int>>(size, linked_query, linked_copy);
+        measure<std::shared_ptr<int>>(size, shared_query, shared_copy);
+        std::printf("%8zu %12.1fns %12.1fns %12.1fns %12.1fns\n", size, linked_query, shared_query, linked_copy,
+                    shared_copy);
+    }
+}
@@ -0,0 +1,201 @@
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_BIASED_LINKED_PTR_HPP
+#define _SMART_PTR_BIASED_LINKED_PTR_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    namespace details {
+        // Its address identifies the running thread
+        inline thread_local char thread_tag = 0;
+
+        inline const void *current_thread() noexcept {
+            return &thread_tag;
+        }
+
+        // Shared part of a biased object: the number of live sub-rings
+        template<typename Deleter>
+        struct BiasedBlock : DeleterHolder<Deleter> {
+            std::atomic<std::size_t> subrings{1};
+
+            explicit BiasedBlock(Deleter deleter) : DeleterHolder<Deleter>(std::move(deleter)) {}
+        };
+    }
+
+    // Shared owner whose ring is split per thread: handles copied on the
+    // thread of their source join its sub-ring with plain, unsynchronized
+    // link updates, and only a copy starting a sub-ring on another thread or
+    // the last handle of a sub-ring going away touches the shared counter of
+    // sub-rings. The object is deleted with the last sub-ring.
+    //
+    // A handle belongs to the thread that made it and must be assigned,
+    // moved from and destroyed there; any thread may copy it meanwhile.
+    // handoff() makes an unbound handle, alone in its sub-ring, that can be
+    // passed to and dropped on any thread. Moving a handle bound to another
+    // thread copies it, as that thread's sub-ring can't be touched here.
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class biased_linked_ptr : private details::Connector {
+        using block = details::BiasedBlock<Deleter>;
+
+        Type *_ptr = nullptr;
+        block *_block = nullptr;
+        // Thread of the sub-ring; null for handed-off handles
+        const void *_thread = nullptr;
+
+        details::Connector &connector() const noexcept {
+            return const_cast<biased_linked_ptr &>(*this);
+        }
+
+        void clear() noexcept {
+            if (!_block)
+                return;
+
+            if (linked()) {
+                assert(_thread == details::current_thread() && "biased_linked_ptr used off its thread");
+                unlink();
+            } else if (_block->subrings.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                _block->deleter()(_ptr);
+                delete _block;
+            }
+            _ptr = nullptr;
+            _block = nullptr;
+            _thread = nullptr;
+        }
+
+        // Joins the sub-ring of `b_ptr` if it is this thread's, otherwise
+        // starts one
+        void copy(const biased_linked_ptr &b_ptr) noexcept {
+            if (_block == b_ptr._block)
+                return;
+
+            clear();
+            if (!b_ptr._block)
+                return;
+
+            _ptr = b_ptr._ptr;
+            _block = b_ptr._block;
+            _thread = details::current_thread();
+            if (b_ptr._thread == _thread)
+                link_after(b_ptr.connector());
+            else
+                _block->subrings.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void move(biased_linked_ptr &b_ptr) noexcept {
+            if (b_ptr._thread && b_ptr._thread != details::current_thread()) {
+                copy(b_ptr);
+                return;
+            }
+
+            _ptr = std::exchange(b_ptr._ptr, nullptr);
+            _block = std::exchange(b_ptr._block, nullptr);
+            _thread = std::exchange(b_ptr._thread, nullptr);
+            take_over(b_ptr);
+        }
+
+    public:
+        constexpr biased_linked_ptr(std::nullptr_t) noexcept : biased_linked_ptr() {}
+
+        constexpr biased_linked_ptr() noexcept {}
+
+        explicit biased_linked_ptr(Type *ptr, Deleter deleter = Deleter())
+                : _ptr(ptr), _block(ptr ? new block(std::move(deleter)) : nullptr),
+                  _thread(ptr ? details::current_thread() : nullptr) {}
+
+        biased_linked_ptr(const biased_linked_ptr &b_ptr) noexcept {
+            copy(b_ptr);
+        }
+
+        biased_linked_ptr(biased_linked_ptr &&b_ptr) noexcept {
+            move(b_ptr);
+        }
+
+        ~biased_linked_ptr() {
+            clear();
+        }
+
+        biased_linked_ptr &operator=(const biased_linked_ptr &b_ptr) noexcept {
+            copy(b_ptr);
+            return *this;
+        }
+
+        biased_linked_ptr &operator=(biased_linked_ptr &&b_ptr) noexcept {
+            if (this != &b_ptr) {
+                clear();
+                move(b_ptr);
+            }
+            return *this;
+        }
+
+        void reset(Type *ptr = nullptr) {
+            block *b = ptr ? new block(Deleter()) : nullptr;
+            clear();
+            _ptr = ptr;
+            _block = b;
+            _thread = ptr ? details::current_thread() : nullptr;
+        }
+
+        // Unbound owner in a sub-ring of its own, for passing to another thread
+        biased_linked_ptr handoff() const noexcept {
+            biased_linked_ptr b_ptr;
+            if (_block) {
+                b_ptr._ptr = _ptr;
+                b_ptr._block = _block;
+                _block->subrings.fetch_add(1, std::memory_order_relaxed);
+            }
+            return b_ptr;
+        }
+
+        void swap(biased_linked_ptr &b_ptr) noexcept {
+            biased_linked_ptr tmp(std::move(b_ptr));
+            b_ptr = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        Type *get() const noexcept {
+            return _ptr;
+        }
+
+        // Number of sub-rings (threads and handed-off handles) owning the
+        // object; a snapshot while other threads copy or release
+        std::size_t subring_count() const noexcept {
+            return _block ? _block->subrings.load(std::memory_order_acquire) : 0;
+        }
+
+        bool unique() const noexcept {
+            return (!linked() && subring_count() == 1);
+        }
+
+        template<typename _Type, typename _Deleter>
+        inline bool operator==(const biased_linked_ptr<_Type, _Deleter> &b_ptr) const noexcept {
+            return (get() == b_ptr.get());
+        }
+
+        template<typename _Type, typename _Deleter>
+        inline bool operator!=(const biased_linked_ptr<_Type, _Deleter> &b_ptr) const noexcept {
+            return (get() != b_ptr.get());
+        }
+
+        Type &operator*() const noexcept {
+            return *get();
+        }
+
+        Type *operator->() const noexcept {
+            return get();
+        }
+
+        inline explicit operator bool() const noexcept {
+            return (get() != nullptr);
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_BIASED_LINKED_PTR_HPP
@@ -0,0 +1,248 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef _SMART_PTR_LINKED_ARENA_HPP
+#define _SMART_PTR_LINKED_ARENA_HPP
+
+namespace smart_ptr {
+
+    template<typename Type, typename Tag>
+    class arena_linked_ptr;
+
+    // Node table backing arena_linked_ptr<Type, Tag>. Ring links are 32-bit
+    // indices into the table, so a handle is a single index. Index 0 is the
+    // "no node" value: null handles own no node at all. Every node carries
+    // the object pointer next to its links, so a non-null handle costs its
+    // 4 bytes plus a 16 byte node; what shrinks is the handle arrays.
+    //
+    // The table is not synchronized: it is owned by the thread holding its
+    // live nodes (checked in debug builds), and passes to another thread
+    // only once empty. Threads working on unrelated objects of the same
+    // Type need distinct Tags. The table is never destroyed, so handles
+    // with static storage may outlive it safely.
+    template<typename Type, typename Tag = void>
+    class linked_arena {
+        template<typename _Type, typename _Tag>
+        friend
+        class arena_linked_ptr;
+
+        struct Node {
+            Type *_ptr = nullptr;
+            std::uint32_t _left = 0;
+            std::uint32_t _right = 0;
+        };
+
+        std::vector<Node> _nodes = std::vector<Node>(1);
+        std::uint32_t _free = 0;
+        std::size_t _live = 0;
+#ifndef NDEBUG
+        std::thread::id _owner;
+#endif
+
+        linked_arena() = default;
+
+        void check_owner() noexcept {
+#ifndef NDEBUG
+            if (!_live)
+                _owner = std::this_thread::get_id();
+            assert(_owner == std::this_thread::get_id() && "linked_arena used from two threads");
+#endif
+        }
+
+        Node &node(std::uint32_t index) noexcept {
+            return _nodes[index];
+        }
+
+        std::uint32_t acquire(Type *ptr) {
+            check_owner();
+            std::uint32_t index = _free;
+            if (index) {
+                _free = _nodes[index]._right;
+            } else {
+                if (_nodes.size() > std::numeric_limits<std::uint32_t>::max())
+                    throw std::length_error("linked_arena: more than 2^32-1 nodes");
+                index = static_cast<std::uint32_t>(_nodes.size());
+                _nodes.emplace_back();
+            }
+            _nodes[index] = Node{ptr, 0, 0};
+            ++_live;
+            return index;
+        }
+
+        void release(std::uint32_t index) noexcept {
+            check_owner();
+            _nodes[index] = Node{nullptr, 0, _free};
+            _free = index;
+            --_live;
+        }
+
+        // Inserts detached node `index` right after node `con`.
+        void attach(std::uint32_t index, std::uint32_t con) noexcept {
+            Node &n = _nodes[index];
+            n._left = con;
+            n._right = _nodes[con]._right;
+            if (n._right)
+                _nodes[n._right]._left = index;
+            _nodes[con]._right = index;
+        }
+
+        void detach(std::uint32_t index) noexcept {
+            Node &n = _nodes[index];
+            if (n._left)
+                _nodes[n._left]._right = n._right;
+            if (n._right)
+                _nodes[n._right]._left = n._left;
+        }
+
+    public:
+        linked_arena(const linked_arena &) = delete;
+
+        linked_arena &operator=(const linked_arena &) = delete;
+
+        static linked_arena &instance() {
+            static linked_arena *const arena = new linked_arena;
+            return *arena;
+        }
+
+        void reserve(std::size_t nodes) {
+            _nodes.reserve(nodes + 1);
+        }
+
+        // Number of non-null handles currently alive
+        std::size_t live() const noexcept {
+            return _live;
+        }
+
+        // Number of node slots, including free ones
+        std::size_t capacity() const noexcept {
+            return _nodes.size() - 1;
+        }
+    };
+
+    // Compact variant of linked_ptr for very large handle arrays: the handle
+    // is one 32-bit index, its ring node lives in linked_arena<Type, Tag>.
+    template<typename Type, typename Tag = void>
+    class arena_linked_ptr {
+        using arena = linked_arena<Type, Tag>;
+
+    private:
+        std::uint32_t _node = 0;
+
+        void clear() {
+            if (!_node)
+                return;
+
+            arena &a = arena::instance();
+            if (unique()) {
+                static_assert(sizeof(Type) > 0, "incomplete type" );
+                delete a.node(_node)._ptr;
+            }
+            a.detach(_node);
+            a.release(_node);
+            _node = 0;
+        }
+
+        void copy(const arena_linked_ptr &l_ptr) {
+            if (get() == l_ptr.get())
+                return;
+
+            clear();
+
+            if (l_ptr._node) {
+                arena &a = arena::instance();
+                _node = a.acquire(a.node(l_ptr._node)._ptr);
+                a.attach(_node, l_ptr._node);
+            }
+        }
+
+    public:
+        constexpr arena_linked_ptr(std::nullptr_t) noexcept : arena_linked_ptr() {}
+
+        constexpr arena_linked_ptr() noexcept {}
+
+        explicit arena_linked_ptr(Type *ptr) {
+            if (ptr)
+                _node = arena::instance().acquire(ptr);
+        }
+
+        arena_linked_ptr(const arena_linked_ptr &l_ptr) {
+            copy(l_ptr);
+        }
+
+        // Takes over the node of `l_ptr`; no arena access, so containers
+        // relocate handles without acquiring new nodes
+        arena_linked_ptr(arena_linked_ptr &&l_ptr) noexcept : _node(l_ptr._node) {
+            l_ptr._node = 0;
+        }
+
+        ~arena_linked_ptr() {
+            clear();
+        }
+
+        void reset(Type *ptr = nullptr) {
+            clear();
+            if (ptr)
+                _node = arena::instance().acquire(ptr);
+        }
+
+        Type *get() const noexcept {
+            return _node ? arena::instance().node(_node)._ptr : nullptr;
+        }
+
+        void swap(arena_linked_ptr &l_ptr) noexcept {
+            std::swap(_node, l_ptr._node);
+        }
+
+        bool unique() const noexcept {
+            if (!_node)
+                return false;
+
+            const auto &n = arena::instance().node(_node);
+            return (!n._left && !n._right);
+        }
+
+        inline bool operator==(const arena_linked_ptr &l_ptr) const noexcept {
+            return (get() == l_ptr.get());
+        }
+
+        inline bool operator!=(const arena_linked_ptr &l_ptr) const noexcept {
+            return (get() != l_ptr.get());
+        }
+
+        inline bool operator<(const arena_linked_ptr &l_ptr) const noexcept {
+            return (get() < l_ptr.get());
+        }
+
+        arena_linked_ptr &operator=(const arena_linked_ptr &l_ptr) {
+            copy(l_ptr);
+            return *this;
+        }
+
+        arena_linked_ptr &operator=(arena_linked_ptr &&l_ptr) noexcept {
+            arena_linked_ptr tmp(std::move(l_ptr));
+            swap(tmp);
+            return *this;
+        }
+
+        Type &operator*() const noexcept {
+            return *get();
+        }
+
+        Type *operator->() const noexcept {
+            return get();
+        }
+
+        inline explicit operator bool() const noexcept {
+            return (_node != 0);
+        }
+    };
+}
+
+#endif //_SMART_PTR_LINKED_ARENA_HPP
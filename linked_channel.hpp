@@ -0,0 +1,185 @@
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "linked_ptr.hpp"
+#include "mpsc_queue.hpp"
+
+#ifndef _SMART_PTR_LINKED_CHANNEL_HPP
+#define _SMART_PTR_LINKED_CHANNEL_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    // Bounded single-producer single-consumer channel of linked_ptr. Handles
+    // are moved into a slot and out of it, so a handle alone in its ring
+    // (the usual case for work items) travels without touching any other
+    // node and without a copy joining the ring. A handle that still shares
+    // its ring has its neighbours re-pointed by both moves, which takes a
+    // SMART_PTR_LINKED_PTR_MT build if they are used on other threads.
+    //
+    // push() and pop() fail instead of blocking when full or empty; the
+    // batch versions move as many handles as fit with a single publication.
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class spsc_channel {
+    public:
+        using value_type = linked_ptr<Type, Deleter>;
+
+    private:
+        const std::size_t _mask;
+        const std::unique_ptr<value_type[]> _slots;
+
+        // Consumer side: its position and last seen producer position
+        alignas(details::cache_line) std::atomic<std::size_t> _head{0};
+        std::size_t _tail_seen = 0;
+
+        // Producer side, likewise
+        alignas(details::cache_line) std::atomic<std::size_t> _tail{0};
+        std::size_t _head_seen = 0;
+
+        // Free slots, rereading the consumer position only if fewer than `wanted`
+        std::size_t free_slots(std::size_t tail, std::size_t wanted) noexcept {
+            if (_mask + 1 - (tail - _head_seen) < wanted)
+                _head_seen = _head.load(std::memory_order_acquire);
+            return _mask + 1 - (tail - _head_seen);
+        }
+
+        std::size_t used_slots(std::size_t head, std::size_t wanted) noexcept {
+            if (_tail_seen - head < wanted)
+                _tail_seen = _tail.load(std::memory_order_acquire);
+            return _tail_seen - head;
+        }
+
+    public:
+        // Capacity is rounded up to a power of two
+        explicit spsc_channel(std::size_t capacity)
+                : _mask(details::queue_capacity(capacity) - 1), _slots(new value_type[_mask + 1]) {}
+
+        spsc_channel(const spsc_channel &) = delete;
+
+        spsc_channel &operator=(const spsc_channel &) = delete;
+
+        std::size_t capacity() const noexcept {
+            return _mask + 1;
+        }
+
+        // Leaves `l_ptr` untouched if the channel is full
+        bool push(value_type &&l_ptr) noexcept {
+            const std::size_t tail = _tail.load(std::memory_order_relaxed);
+            if (!free_slots(tail, 1))
+                return false;
+            _slots[tail & _mask] = std::move(l_ptr);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Moves from the front of [first, first + count); returns how many
+        std::size_t push(value_type *first, std::size_t count) noexcept {
+            const std::size_t tail = _tail.load(std::memory_order_relaxed);
+            const std::size_t free = free_slots(tail, count);
+            const std::size_t n = count < free ? count : free;
+            for (std::size_t i = 0; i < n; ++i)
+                _slots[(tail + i) & _mask] = std::move(first[i]);
+            if (n)
+                _tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        bool pop(value_type &l_ptr) noexcept {
+            const std::size_t head = _head.load(std::memory_order_relaxed);
+            if (!used_slots(head, 1))
+                return false;
+            l_ptr = std::move(_slots[head & _mask]);
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Moves up to `count` handles into `out`; returns how many
+        std::size_t pop(value_type *out, std::size_t count) noexcept {
+            const std::size_t head = _head.load(std::memory_order_relaxed);
+            const std::size_t used = used_slots(head, count);
+            const std::size_t n = count < used ? count : used;
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = std::move(_slots[(head + i) & _mask]);
+            if (n)
+                _head.store(head + n, std::memory_order_release);
+            return n;
+        }
+    };
+
+    // Bounded multi-producer single-consumer channel of linked_ptr, with the
+    // same handoff as spsc_channel. Producers claim slots with a CAS on the
+    // tail and publish each through its own sequence number, which the
+    // consumer also uses to hand slots back.
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class mpsc_channel {
+    public:
+        using value_type = linked_ptr<Type, Deleter>;
+
+    private:
+        details::mpsc_queue<value_type> _queue;
+
+        void fill(std::size_t position, value_type &&l_ptr) noexcept {
+            _queue.at(position) = std::move(l_ptr);
+            _queue.publish(position);
+        }
+
+    public:
+        // Capacity is rounded up to a power of two
+        explicit mpsc_channel(std::size_t capacity) : _queue(capacity) {}
+
+        mpsc_channel(const mpsc_channel &) = delete;
+
+        mpsc_channel &operator=(const mpsc_channel &) = delete;
+
+        std::size_t capacity() const noexcept {
+            return _queue.capacity();
+        }
+
+        // Leaves `l_ptr` untouched if the channel is full
+        bool push(value_type &&l_ptr) noexcept {
+            std::size_t count = 1;
+            const std::size_t position = _queue.claim(count);
+            if (!count)
+                return false;
+            fill(position, std::move(l_ptr));
+            return true;
+        }
+
+        // Moves from the front of [first, first + count); returns how many
+        std::size_t push(value_type *first, std::size_t count) noexcept {
+            std::size_t pushed = 0;
+            while (pushed < count) {
+                std::size_t n = count - pushed;
+                const std::size_t position = _queue.claim(n);
+                if (!n)
+                    break;
+                for (std::size_t i = 0; i < n; ++i)
+                    fill(position + i, std::move(first[pushed + i]));
+                pushed += n;
+            }
+            return pushed;
+        }
+
+        bool pop(value_type &l_ptr) noexcept {
+            value_type *front = _queue.front();
+            if (!front)
+                return false;
+            l_ptr = std::move(*front);
+            _queue.pop();
+            return true;
+        }
+
+        // Moves up to `count` handles into `out`; returns how many
+        std::size_t pop(value_type *out, std::size_t count) noexcept {
+            std::size_t n = 0;
+            while (n < count && pop(out[n]))
+                ++n;
+            return n;
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_CHANNEL_HPP
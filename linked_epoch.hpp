@@ -0,0 +1,291 @@
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+#include "linked_ptr.hpp"
+#include "mpsc_queue.hpp"
+
+#ifndef _SMART_PTR_LINKED_EPOCH_HPP
+#define _SMART_PTR_LINKED_EPOCH_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    class epoch_guard;
+
+    // Epoch-based reclamation: objects released into the domain are only
+    // destroyed once every reader that might still see them has left its
+    // critical section. Readers register once per thread (epoch_domain::
+    // reader) and pin() around traversals, which costs one atomic exchange
+    // rather than a count update per node visited. Ordering between pins
+    // and retirements comes from seq_cst operations on the epoch and the
+    // reader slots only (no standalone fences, which TSan cannot model).
+    //
+    // Retired objects wait in a bounded queue allocated up front, so
+    // retire() neither allocates nor throws. When the queue is full the
+    // retiring thread waits out a grace period itself and destroys the
+    // object inline; it must not be pinned in this domain then. Queued
+    // objects are destroyed by whichever thread calls collect(), which
+    // retire() does every `batch` retirements. Objects whose destruction
+    // touches rings shared with other threads therefore need those rings
+    // to be thread-safe, or collection confined to one thread. The domain
+    // must outlive its readers and the handles retiring into it.
+    class epoch_domain {
+        struct retired {
+            void *ptr;
+            void (*dispose)(void *context, void *ptr);
+            std::uint64_t epoch;
+        };
+
+        // Per-thread state: 0 while quiescent, (epoch << 1) | 1 while pinned
+        struct participant {
+            std::atomic<std::uint64_t> state{0};
+            std::atomic<bool> in_use{true};
+            participant *next = nullptr;
+        };
+
+        std::atomic<std::uint64_t> _epoch{0};
+        std::atomic<participant *> _participants{nullptr};
+        details::mpsc_queue<retired> _queue;
+        std::atomic<std::size_t> _pending{0};
+        std::atomic<std::size_t> _reclaimed{0};
+        std::atomic<std::size_t> _retirements{0};
+        std::atomic_flag _collecting = ATOMIC_FLAG_INIT;
+        const std::size_t _batch;
+
+        participant *acquire_participant() {
+            for (participant *p = _participants.load(std::memory_order_acquire); p; p = p->next) {
+                bool expected = false;
+                if (!p->in_use.load(std::memory_order_relaxed) &&
+                    p->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return p;
+            }
+
+            participant *p = new participant;
+            p->next = _participants.load(std::memory_order_relaxed);
+            while (!_participants.compare_exchange_weak(p->next, p,
+                                                        std::memory_order_release, std::memory_order_relaxed)) {}
+            return p;
+        }
+
+        // Moves to the next epoch if every pinned reader has seen this one
+        bool try_advance() noexcept {
+            std::uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+            for (participant *p = _participants.load(std::memory_order_acquire); p; p = p->next) {
+                const std::uint64_t state = p->state.load(std::memory_order_seq_cst);
+                if ((state & 1) && (state >> 1) != epoch)
+                    return false;
+            }
+            return _epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+        }
+
+        // Claims and fills the next slot; false if the queue is full
+        bool push(void *ptr, void (*dispose)(void *context, void *ptr), std::uint64_t epoch) noexcept {
+            std::size_t count = 1;
+            const std::size_t position = _queue.claim(count);
+            if (!count)
+                return false;
+
+            _pending.fetch_add(1, std::memory_order_relaxed);
+            _queue.at(position) = retired{ptr, dispose, epoch};
+            _queue.publish(position);
+            return true;
+        }
+
+        // Destroys queued objects retired before `safe` (all if ~0), oldest
+        // first, up to the first one that is not; the caller is the only
+        // consumer. Destructors may retire more objects meanwhile.
+        std::size_t reclaim(std::uint64_t safe) noexcept {
+            std::size_t count = 0;
+            for (const retired *front; (front = _queue.front()) && front->epoch < safe; ++count) {
+                const retired item = *front;
+                _queue.pop();
+                item.dispose(nullptr, item.ptr);
+            }
+
+            if (count) {
+                _reclaimed.fetch_add(count, std::memory_order_relaxed);
+                _pending.fetch_sub(count, std::memory_order_release);
+            }
+            return count;
+        }
+
+    public:
+        class reader;
+
+        // `batch` is the number of retirements between two collections,
+        // `capacity` (rounded up to a power of two) bounds the objects queued
+        explicit epoch_domain(std::size_t batch = 64, std::size_t capacity = 4096)
+                : _queue(capacity), _batch(batch ? batch : 1) {}
+
+        epoch_domain(const epoch_domain &) = delete;
+
+        epoch_domain &operator=(const epoch_domain &) = delete;
+
+        // Destroys whatever is still retired; no reader may be pinned
+        ~epoch_domain() {
+            while (_pending.load(std::memory_order_acquire))
+                reclaim(~std::uint64_t(0));
+            for (participant *p = _participants.load(std::memory_order_acquire), *next; p; p = next) {
+                next = p->next;
+                assert(!(p->state.load(std::memory_order_relaxed) & 1) && "epoch_domain destroyed while pinned");
+                delete p;
+            }
+        }
+
+        // Queues `ptr` for deletion as a Type once no reader can reach it;
+        // the object must already be unreachable for new readers
+        template<typename Type>
+        void retire(Type *ptr) noexcept {
+            const std::uint64_t epoch = stamp();
+            if (!push(details::erase_ptr(ptr), &details::delete_owned<Type>, epoch)) {
+                while (!passed(epoch))
+                    std::this_thread::yield();
+                details::delete_owned<Type>(nullptr, details::erase_ptr(ptr));
+                return;
+            }
+
+            if ((_retirements.fetch_add(1, std::memory_order_relaxed) + 1) % _batch == 0)
+                collect();
+        }
+
+        // Epoch stamp of something just made unreachable for new readers.
+        // A read-modify-write, so it is ordered after the unlinking stores
+        // like any seq_cst operation on the reader slots.
+        std::uint64_t stamp() noexcept {
+            return _epoch.fetch_add(0, std::memory_order_seq_cst);
+        }
+
+        // Whether every reader that could have seen something stamped
+        // `epoch` has left since (two epochs later); advances if it can
+        bool passed(std::uint64_t epoch) noexcept {
+            if (_epoch.load(std::memory_order_acquire) < epoch + 2)
+                try_advance();
+            return _epoch.load(std::memory_order_acquire) >= epoch + 2;
+        }
+
+        // Advances the epoch if possible and destroys what no reader can
+        // see any more; returns the count. Skipped while another thread
+        // collects.
+        std::size_t collect() noexcept {
+            if (_collecting.test_and_set(std::memory_order_acquire))
+                return 0;
+            try_advance();
+            // Objects retired two epochs ago predate every pinned reader
+            const std::uint64_t epoch = _epoch.load(std::memory_order_acquire);
+            const std::size_t count = epoch >= 2 ? reclaim(epoch - 1) : 0;
+            _collecting.clear(std::memory_order_release);
+            return count;
+        }
+
+        // Objects retired but not destroyed yet
+        std::size_t pending() const noexcept {
+            return _pending.load(std::memory_order_acquire);
+        }
+
+        // Objects destroyed by collections so far (not inline fallbacks)
+        std::size_t reclaimed() const noexcept {
+            return _reclaimed.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t epoch() const noexcept {
+            return _epoch.load(std::memory_order_relaxed);
+        }
+
+        // Process-wide domain of default constructed epoch_delete
+        static epoch_domain &global() {
+            static epoch_domain domain;
+            return domain;
+        }
+    };
+
+    // A thread's registration with an epoch_domain; pins nest.
+    class epoch_domain::reader {
+        epoch_domain &_domain;
+        participant *_record;
+        unsigned _depth = 0;
+
+    public:
+        explicit reader(epoch_domain &domain = epoch_domain::global())
+                : _domain(domain), _record(domain.acquire_participant()) {}
+
+        reader(const reader &) = delete;
+
+        reader &operator=(const reader &) = delete;
+
+        ~reader() {
+            assert(!_depth && "epoch_domain::reader destroyed while pinned");
+            _record->in_use.store(false, std::memory_order_release);
+        }
+
+        void enter() noexcept {
+            if (_depth++)
+                return;
+            const std::uint64_t epoch = _domain._epoch.load(std::memory_order_seq_cst);
+            _record->state.exchange((epoch << 1) | 1, std::memory_order_seq_cst);
+        }
+
+        void leave() noexcept {
+            if (!--_depth)
+                _record->state.store(0, std::memory_order_release);
+        }
+
+        epoch_guard pin() noexcept;
+    };
+
+    // Critical section of a reader, from pin() to destruction
+    class epoch_guard {
+        epoch_domain::reader *_reader;
+
+    public:
+        explicit epoch_guard(epoch_domain::reader &reader) noexcept : _reader(&reader) {
+            reader.enter();
+        }
+
+        epoch_guard(epoch_guard &&guard) noexcept : _reader(guard._reader) {
+            guard._reader = nullptr;
+        }
+
+        epoch_guard(const epoch_guard &) = delete;
+
+        epoch_guard &operator=(const epoch_guard &) = delete;
+
+        ~epoch_guard() {
+            if (_reader)
+                _reader->leave();
+        }
+    };
+
+    inline epoch_guard epoch_domain::reader::pin() noexcept {
+        return epoch_guard(*this);
+    }
+
+    // Deleter retiring objects into an epoch_domain (the global one if none
+    // is given) instead of destroying them while readers may see them.
+    // linked_ptr<T[]> rejects it at compile time.
+    class epoch_delete {
+        epoch_domain *_domain = nullptr;
+
+    public:
+        using single_object = std::true_type;
+
+        constexpr epoch_delete() noexcept = default;
+
+        explicit epoch_delete(epoch_domain &domain) noexcept : _domain(&domain) {}
+
+        epoch_domain &domain() const {
+            return _domain ? *_domain : epoch_domain::global();
+        }
+
+        template<typename Type>
+        void operator()(Type *ptr) const {
+            domain().retire(ptr);
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_EPOCH_HPP
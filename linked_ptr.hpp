@@ -1,58 +1,816 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <type_traits>
 #include <utility>
 
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#ifdef SMART_PTR_LINKED_PTR_MT
+#include <thread>
+#endif
+
 #ifndef _SMART_PTR_LINKED_PTR_HPP
 #define _SMART_PTR_LINKED_PTR_HPP
 
+// SMART_PTR_LINKED_PTR_MT changes the layout and behaviour of the ring, so
+// everything built on it lives in an inline namespace named after the
+// mode: translation units compiled with and without the macro get
+// distinct types and fail to link when handles cross between them,
+// instead of silently sharing one definition.
+#ifdef SMART_PTR_LINKED_PTR_MT
+#define SMART_PTR_BEGIN_MODE inline namespace mt {
+#else
+#define SMART_PTR_BEGIN_MODE inline namespace st {
+#endif
+#define SMART_PTR_END_MODE }
+
 namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
 
     namespace details {
+#ifdef SMART_PTR_LINKED_PTR_MT
+        inline void spin_pause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+#endif
+
+        // Ring node embedded into every linked_ptr: owners of one object
+        // form a doubly linked list, so no per-pointer heap nodes are needed.
+        // Weak (non-owning) members are marked by the low bit of their own
+        // `_left`, which every link update preserves.
+        //
+        // Built with SMART_PTR_LINKED_PTR_MT, the low bit of `_right` is a
+        // spin lock guarding both links of the node. attach(), detach(),
+        // take(), swap() and release() lock the node and its neighbours
+        // (try-locking all of them and backing off on contention), so
+        // handles of one ring may be copied and destroyed on different
+        // threads while only the touched neighbourhood is written. Weak
+        // members would make release() walk and write past the locked nodes,
+        // so linked_weak_ptr (and what builds on it) is rejected in MT builds;
+        // use_count() and relocation walk the ring unsynchronized.
         struct Connector {
-            Connector *_conWith = nullptr;
+            Connector *_left = nullptr;
+            Connector *_right = nullptr;
+
+            constexpr Connector() noexcept = default;
+
+            Connector(const Connector &) = delete;
+
+            Connector &operator=(const Connector &) = delete;
+
+            inline bool linked() const noexcept {
+                return left() || right();
+            }
+
+            inline bool weak() const noexcept {
+                return tag(load_link(_left)) & weak_bit;
+            }
+
+            // Marks a detached node as a weak member
+            void make_weak() noexcept {
+                store_link(_left, reinterpret_cast<Connector *>(weak_bit));
+            }
+
+            inline Connector *left() const noexcept {
+                return untag(load_link(_left), weak_bit);
+            }
+
+            inline Connector *right() const noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                return untag(load_link(_right), lock_bit);
+#else
+                return _right;
+#endif
+            }
+
+            // Whether another owning member is in the ring; stops at the
+            // first one, so only runs of weak neighbours are walked.
+            bool shared() const noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                Lock lock;
+                lock.neighbourhood(const_cast<Connector &>(*this));
+#endif
+                return has_owner();
+            }
+
+            // Number of owning nodes in the ring, walking both directions
+            std::size_t ring_size() const noexcept {
+                std::size_t size = weak() ? 0 : 1;
+                for (const Connector *con = left(); con; con = con->left())
+                    size += !con->weak();
+                for (const Connector *con = right(); con; con = con->right())
+                    size += !con->weak();
+                return size;
+            }
+
+            // Detaches every weak member of the ring, once its last owner goes.
+            void expire_weak() noexcept {
+                for (Connector *con = left(), *next; con; con = next) {
+                    next = con->left();
+                    if (con->weak())
+                        con->unlink();
+                }
+                for (Connector *con = right(), *next; con; con = next) {
+                    next = con->right();
+                    if (con->weak())
+                        con->unlink();
+                }
+            }
+
+            // Forgets the ring without touching neighbours, which are being
+            // destroyed along with this node.
+            void abandon() noexcept {
+                set_left(nullptr);
+                set_right(nullptr);
+            }
+
+            // Inserts this (detached) node right after `con`.
+            void attach(Connector &con) noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                Lock lock;
+                while (!(lock.add(&con) && lock.add(con.right()) && lock.add(this)))
+                    lock.back_off();
+#endif
+                link_after(con);
+            }
+
+            void detach() noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                Lock lock;
+                lock.neighbourhood(*this);
+#endif
+                unlink();
+            }
+
+            // Detaches an owning node; true if it was the last owner of the
+            // ring, whose weak members are then expired as well.
+            bool release() noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                Lock lock;
+                lock.neighbourhood(*this);
+#endif
+                const bool last = !has_owner();
+                if (last)
+                    expire_weak();
+                unlink();
+                return last;
+            }
+
+            // Same, but leaves the node in place unless it is the last owner
+            bool release_last() noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                Lock lock;
+                lock.neighbourhood(*this);
+#endif
+                if (has_owner())
+                    return false;
+                expire_weak();
+                unlink();
+                return true;
+            }
+
+            // Takes over the ring position of `con`, leaving `con` detached.
+            void take(Connector &con) noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                Lock lock;
+                while (!(lock.add(&con) && lock.add(con.left()) && lock.add(con.right()) && lock.add(this)))
+                    lock.back_off();
+#endif
+                take_over(con);
+            }
+
+            // Exchanges ring positions of two nodes, including adjacent ones.
+            void swap(Connector &con) noexcept {
+                if (this == &con)
+                    return;
+
+#ifdef SMART_PTR_LINKED_PTR_MT
+                Lock lock;
+                while (!(lock.add(this) && lock.add(&con) && lock.add(left()) && lock.add(right()) &&
+                         lock.add(con.left()) && lock.add(con.right())))
+                    lock.back_off();
+#endif
+                Connector *l = left(), *r = right();
+                Connector *con_l = con.left(), *con_r = con.right();
+
+                set_left(con_l == this ? &con : con_l);
+                set_right(con_r == this ? &con : con_r);
+                con.set_left(l == &con ? this : l);
+                con.set_right(r == &con ? this : r);
+
+                relink();
+                con.relink();
+            }
+
+            // Repairs links after this node was memcpy'd out of the block
+            // [begin, end) to an address `shift` bytes away. Links into the
+            // block are translated, outside neighbours are re-pointed.
+            void relocated(std::uintptr_t begin, std::uintptr_t end, std::uintptr_t shift) noexcept {
+                Connector *l = left();
+                if (within(l, begin, end))
+                    set_left(shifted(l, shift));
+                else if (l)
+                    l->set_right(this);
+
+                Connector *r = right();
+                if (within(r, begin, end))
+                    set_right(shifted(r, shift));
+                else if (r)
+                    r->set_left(this);
+            }
+
+            // Unlocked bodies of the operations above; in MT builds the
+            // caller holds the locks of every node they write.
+
+            bool has_owner() const noexcept {
+                for (const Connector *con = left(); con; con = con->left())
+                    if (!con->weak())
+                        return true;
+                for (const Connector *con = right(); con; con = con->right())
+                    if (!con->weak())
+                        return true;
+                return false;
+            }
+
+            void link_after(Connector &con) noexcept {
+                Connector *r = con.right();
+                set_left(&con);
+                set_right(r);
+                if (r)
+                    r->set_left(this);
+                con.set_right(this);
+            }
+
+            void unlink() noexcept {
+                Connector *l = left(), *r = right();
+                if (l)
+                    l->set_right(r);
+                if (r)
+                    r->set_left(l);
+                set_left(nullptr);
+                set_right(nullptr);
+            }
+
+            void take_over(Connector &con) noexcept {
+                set_left(con.left());
+                set_right(con.right());
+                con.set_left(nullptr);
+                con.set_right(nullptr);
+                relink();
+            }
+
+#ifdef SMART_PTR_LINKED_PTR_MT
+            bool try_lock() noexcept {
+                Connector *right = untag(load_link(_right), lock_bit);
+                return __atomic_compare_exchange_n(&_right, &right, tagged(right, lock_bit), false,
+                                                   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+            }
+
+            void unlock() noexcept {
+                __atomic_store_n(&_right, untag(load_link(_right), lock_bit), __ATOMIC_RELEASE);
+            }
+
+            // Set of node locks taken together. add() only try-locks, so a
+            // failed acquisition releases everything and starts over instead
+            // of waiting in some lock order.
+            class Lock {
+                Connector *_held[8];
+                unsigned _count = 0;
+                unsigned _failures = 0;
+
+            public:
+                Lock() noexcept = default;
+
+                Lock(const Lock &) = delete;
+
+                Lock &operator=(const Lock &) = delete;
+
+                ~Lock() {
+                    release();
+                }
+
+                // Locks `con` unless it is null or already held; false if busy
+                bool add(Connector *con) noexcept {
+                    if (!con)
+                        return true;
+                    for (unsigned i = 0; i < _count; ++i)
+                        if (_held[i] == con)
+                            return true;
+                    if (!con->try_lock())
+                        return false;
+                    _held[_count++] = con;
+                    return true;
+                }
+
+                // Locks `con` and both its neighbours
+                void neighbourhood(Connector &con) noexcept {
+                    while (!(add(&con) && add(con.left()) && add(con.right())))
+                        back_off();
+                }
+
+                // Drops every lock after a failed add() and waits, longer
+                // the more often this acquisition failed
+                void back_off() noexcept {
+                    release();
+                    if (_failures < 10) {
+                        for (unsigned i = 0, n = 1u << _failures++; i < n; ++i)
+                            spin_pause();
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+
+                void release() noexcept {
+                    while (_count)
+                        _held[--_count]->unlock();
+                }
+            };
+#endif
+
+        private:
+            static constexpr std::uintptr_t weak_bit = 1;
+#ifdef SMART_PTR_LINKED_PTR_MT
+            static constexpr std::uintptr_t lock_bit = 1;
+
+            static Connector *load_link(Connector *const &link) noexcept {
+                return __atomic_load_n(&link, __ATOMIC_RELAXED);
+            }
+
+            static void store_link(Connector *&link, Connector *con) noexcept {
+                __atomic_store_n(&link, con, __ATOMIC_RELAXED);
+            }
+#else
+            static Connector *load_link(Connector *const &link) noexcept {
+                return link;
+            }
+
+            static void store_link(Connector *&link, Connector *con) noexcept {
+                link = con;
+            }
+#endif
+
+            static std::uintptr_t tag(const Connector *con) noexcept {
+                return reinterpret_cast<std::uintptr_t>(con);
+            }
+
+            static Connector *untag(Connector *con, std::uintptr_t bits) noexcept {
+                return reinterpret_cast<Connector *>(tag(con) & ~bits);
+            }
+
+            static Connector *tagged(Connector *con, std::uintptr_t bits) noexcept {
+                return reinterpret_cast<Connector *>(tag(con) | bits);
+            }
+
+            void set_left(Connector *con) noexcept {
+                store_link(_left, tagged(con, tag(load_link(_left)) & weak_bit));
+            }
+
+            void set_right(Connector *con) noexcept {
+#ifdef SMART_PTR_LINKED_PTR_MT
+                store_link(_right, tagged(con, tag(load_link(_right)) & lock_bit));
+#else
+                _right = con;
+#endif
+            }
+
+            static bool within(const Connector *con, std::uintptr_t begin, std::uintptr_t end) noexcept {
+                std::uintptr_t address = reinterpret_cast<std::uintptr_t>(con);
+                return (address >= begin && address < end);
+            }
+
+            static Connector *shifted(Connector *con, std::uintptr_t shift) noexcept {
+                return reinterpret_cast<Connector *>(reinterpret_cast<std::uintptr_t>(con) + shift);
+            }
+
+            void relink() noexcept {
+                if (Connector *l = left())
+                    l->set_right(this);
+                if (Connector *r = right())
+                    r->set_left(this);
+            }
+        };
+
+        struct BulkAccess;
+
+        struct PointerCast;
+
+        struct RingAccess;
+
+        template<typename>
+        constexpr bool always_false_v = false;
+
+        // Deleters may report through `abandon()` that every handle of
+        // their object is being torn down at once (see linked_region);
+        // handles then drop their links instead of unlinking one by one.
+        template<typename Deleter, typename = void>
+        constexpr bool is_abandonable_v = false;
+
+        template<typename Deleter>
+        constexpr bool is_abandonable_v<
+                Deleter, std::void_t<decltype(std::declval<Deleter &>().abandon())>
+        > = true;
+
+        // Deleters that free single objects only (they cannot tell an
+        // element pointer from an object pointer) declare a `single_object`
+        // member type; linked_ptr<T[]> rejects them.
+        template<typename Deleter, typename = void>
+        constexpr bool is_single_object_v = false;
+
+        template<typename Deleter>
+        constexpr bool is_single_object_v<
+                Deleter, std::void_t<typename Deleter::single_object>
+        > = true;
+
+        // Stores the deleter of a linked_ptr; empty deleters take no space.
+        template<
+                typename Deleter,
+                bool = std::is_empty_v<Deleter> && !std::is_final_v<Deleter>
+        >
+        class DeleterHolder : private Deleter {
+        public:
+            constexpr DeleterHolder() = default;
+
+            explicit DeleterHolder(Deleter deleter) : Deleter(std::move(deleter)) {}
+
+            Deleter &deleter() noexcept {
+                return *this;
+            }
+
+            const Deleter &deleter() const noexcept {
+                return *this;
+            }
+        };
+
+        template<typename Deleter>
+        class DeleterHolder<Deleter, false> {
+            Deleter _deleter{};
+
+        public:
+            constexpr DeleterHolder() = default;
+
+            explicit DeleterHolder(Deleter deleter) : _deleter(std::move(deleter)) {}
+
+            Deleter &deleter() noexcept {
+                return _deleter;
+            }
+
+            const Deleter &deleter() const noexcept {
+                return _deleter;
+            }
+        };
+
+        // Element count of a linked_ptr<T[]>; single objects store nothing.
+        template<bool = true>
+        class ExtentHolder {
+            std::size_t _extent = 0;
+
+        public:
+            std::size_t extent() const noexcept {
+                return _extent;
+            }
+
+            void set_extent(std::size_t extent) noexcept {
+                _extent = extent;
+            }
+        };
 
-            inline explicit operator bool() const noexcept {
-                return _conWith != nullptr;
+        template<>
+        class ExtentHolder<false> {
+        public:
+            static constexpr std::size_t extent() noexcept {
+                return 1;
             }
+
+            void set_extent(std::size_t) noexcept {}
         };
     }
-    template<typename Type>
-    class linked_ptr {
-        template<typename _Type>
+
+    namespace details {
+        template<typename Type>
+        void delete_owned(void *, void *owned) {
+            static_assert(sizeof(std::remove_extent_t<Type>) > 0, "incomplete type" );
+            std::default_delete<Type>()(static_cast<std::remove_extent_t<Type> *>(owned));
+        }
+
+        // Deleters small enough to be carried in the context pointer
+        template<typename Deleter>
+        constexpr bool is_packable_v = std::is_trivially_copyable_v<Deleter> &&
+                                       sizeof(Deleter) <= sizeof(void *) && alignof(Deleter) <= alignof(void *);
+
+        template<typename Deleter>
+        void *pack_deleter(const Deleter &deleter) noexcept {
+            void *context = nullptr;
+            std::memcpy(static_cast<void *>(&context), static_cast<const void *>(&deleter), sizeof(Deleter));
+            return context;
+        }
+
+        // Calls a deleter packed into `context` on the Owned object
+        template<typename Owned, typename Deleter>
+        void delete_packed(void *context, void *owned) {
+            alignas(Deleter) unsigned char bytes[sizeof(Deleter)];
+            std::memcpy(bytes, static_cast<const void *>(&context), sizeof(Deleter));
+            (*std::launder(reinterpret_cast<Deleter *>(bytes)))(static_cast<std::remove_extent_t<Owned> *>(owned));
+        }
+
+        inline void *erase_ptr(const volatile void *ptr) noexcept {
+            return const_cast<void *>(ptr);
+        }
+    }
+
+    // Type-erased deleter chosen at run time: `dispose(context, ptr)` frees
+    // the object, `ptr` being the pointer held by the handle unless the
+    // deleter remembers the owned object itself. Raw pointers adopted by
+    // linked_ptr<T, any_deleter> get an owning() deleter that deletes the
+    // object through its original type, aliases get an aliasing() one. A
+    // default constructed any_deleter frees nothing.
+    class any_deleter {
+        void (*_dispose)(void *context, void *ptr) = nullptr;
+        void *_context = nullptr;
+        void *_owned = nullptr;
+
+    public:
+        constexpr any_deleter() noexcept = default;
+
+        constexpr any_deleter(void (*dispose)(void *context, void *ptr), void *context = nullptr) noexcept
+                : _dispose(dispose), _context(context) {}
+
+        template<typename Type>
+        static any_deleter owning(Type *ptr) noexcept {
+            return any_deleter(&details::delete_owned<Type>).aliasing(ptr);
+        }
+
+        // Same for an array from new[], e.g. owning<int[]>(ptr)
+        template<typename Type, typename = std::enable_if_t<std::is_array_v<Type>>>
+        static any_deleter owning(std::remove_extent_t<Type> *ptr) noexcept {
+            return any_deleter(&details::delete_owned<Type>).aliasing(ptr);
+        }
+
+        // Copy that frees `owned` whatever the handle points to, unless this
+        // one already remembers its object
+        any_deleter aliasing(const volatile void *owned) const noexcept {
+            any_deleter deleter = *this;
+            if (!deleter._owned)
+                deleter._owned = details::erase_ptr(owned);
+            return deleter;
+        }
+
+        template<typename Type>
+        void operator()(Type *ptr) const {
+            if (_dispose)
+                _dispose(_context, _owned ? _owned : details::erase_ptr(ptr));
+        }
+    };
+
+    namespace details {
+        // Type of the object(s) a linked_ptr<Type> owns through an `_Type *`
+        template<typename Type, typename _Type>
+        using owned_t = std::conditional_t<std::is_array_v<Type>, _Type[], _Type>;
+
+        // Deleter adopted together with a raw pointer to an Owned object
+        template<typename Deleter, typename Owned>
+        Deleter adopt_deleter(std::remove_extent_t<Owned> *ptr) {
+            if constexpr (std::is_same_v<Deleter, any_deleter>)
+                return any_deleter::owning<Owned>(ptr);
+            else
+                return Deleter();
+        }
+
+        // Deleter of a handle converted from an Owned one with `deleter` and `ptr`
+        template<typename Deleter, typename Owned, typename _Deleter>
+        Deleter convert_deleter(_Deleter &&deleter, std::remove_extent_t<Owned> *ptr) {
+            if constexpr (std::is_same_v<Deleter, any_deleter> &&
+                          std::is_same_v<std::decay_t<_Deleter>, std::default_delete<Owned>>)
+                return any_deleter::owning<Owned>(ptr);
+            else
+                return Deleter(std::forward<_Deleter>(deleter));
+        }
+
+        // Deleter of an alias of the Owned object `ptr` of a handle with `deleter`
+        template<typename Owned, typename _Deleter>
+        any_deleter alias_deleter(const _Deleter &deleter, std::remove_extent_t<Owned> *ptr) noexcept {
+            if constexpr (std::is_same_v<_Deleter, any_deleter>)
+                return deleter.aliasing(ptr);
+            else
+                return any_deleter(&delete_packed<Owned, _Deleter>, pack_deleter(deleter)).aliasing(ptr);
+        }
+
+        template<typename _Deleter>
+        constexpr bool is_aliasable_v = std::is_same_v<_Deleter, any_deleter> || is_packable_v<_Deleter>;
+
+        // Deleter of a handle cast to Type: default_delete is rebound to the
+        // new type; any other deleter would be called with the cast pointer,
+        // so the cast gets an any_deleter remembering the original object
+        template<typename Deleter, typename Type>
+        struct rebind_deleter {
+            static_assert(is_aliasable_v<Deleter>,
+                          "pointer casts need default_delete, any_deleter or a small trivially copyable deleter");
+            using type = any_deleter;
+        };
+
+        template<typename _Type, typename Type>
+        struct rebind_deleter<std::default_delete<_Type>, Type> {
+            using type = std::default_delete<Type>;
+        };
+
+        template<typename Deleter, typename Type>
+        using rebind_deleter_t = typename rebind_deleter<Deleter, Type>::type;
+
+        template<typename _Deleter, typename Deleter, typename _Type>
+        constexpr bool is_deleter_convertible_v =
+                std::is_convertible_v<const _Deleter &, Deleter> ||
+                (std::is_same_v<Deleter, any_deleter> && std::is_same_v<_Deleter, std::default_delete<_Type>>);
+    }
+
+    // Deleter for objects obtained from an allocator. Converted handles
+    // (linked_ptr<Base> from linked_ptr<Derived>) keep the original deleter
+    // type, so the object is destroyed and freed as Alloc::value_type.
+    template<typename Alloc>
+    class allocator_delete {
+        template<typename _Alloc>
+        friend
+        class allocator_delete;
+
+        using traits = std::allocator_traits<Alloc>;
+        using value_type = typename traits::value_type;
+
+        Alloc _alloc;
+
+    public:
+        allocator_delete() = default;
+
+        explicit allocator_delete(const Alloc &alloc) noexcept : _alloc(alloc) {}
+
+        allocator_delete(const allocator_delete &) = default;
+
+        allocator_delete &operator=(const allocator_delete &deleter) noexcept {
+            // Allocators such as std::pmr::polymorphic_allocator are not assignable
+            if (this != &deleter) {
+                _alloc.~Alloc();
+                ::new (static_cast<void *>(&_alloc)) Alloc(deleter._alloc);
+            }
+            return *this;
+        }
+
+        const Alloc &get_allocator() const noexcept {
+            return _alloc;
+        }
+
+        template<typename Type>
+        void operator()(Type *ptr) {
+            value_type *object = static_cast<value_type *>(ptr);
+            traits::destroy(_alloc, object);
+            traits::deallocate(_alloc, object, 1);
+        }
+    };
+
+    template<typename Type, typename Deleter>
+    class linked_ptr;
+
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class linked_weak_ptr;
+
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class enable_linked_from_this;
+
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class atomic_linked_ptr;
+
+    namespace details {
+        template<typename Owner>
+        void bind_from_this(const Owner &owner, const volatile void *ptr) noexcept;
+
+        template<typename Owner, typename Type, typename Deleter>
+        void bind_from_this(const Owner &owner, const enable_linked_from_this<Type, Deleter> *ptr) noexcept;
+    }
+
+    template<typename Type, typename Deleter>
+    void relocate(linked_ptr<Type, Deleter> *first, linked_ptr<Type, Deleter> *last,
+                  linked_ptr<Type, Deleter> *dest) noexcept;
+
+    // Shared owner of a single object, or of an array for linked_ptr<T[]>
+    // (deleted with delete[], indexed with operator[], optionally sized).
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class linked_ptr : private details::Connector, private details::DeleterHolder<Deleter>,
+                       private details::ExtentHolder<std::is_array_v<Type>> {
+        template<typename _Type, typename _Deleter>
         friend
         class linked_ptr;
 
+        template<typename _Type, typename _Deleter>
+        friend
+        class linked_weak_ptr;
+
+        template<typename _Type, typename _Deleter>
+        friend
+        class atomic_linked_ptr;
+
+        friend struct details::BulkAccess;
+
+        friend struct details::PointerCast;
+
+        friend void relocate<>(linked_ptr *first, linked_ptr *last, linked_ptr *dest) noexcept;
+
+        using holder = details::DeleterHolder<Deleter>;
+        using holder::deleter;
+
+        using extent_holder = details::ExtentHolder<std::is_array_v<Type>>;
+        using extent_holder::extent;
+        using extent_holder::set_extent;
+
+    public:
+        using element_type = std::remove_extent_t<Type>;
+        using deleter_type = Deleter;
+
     private:
-        details::Connector * _left = new details::Connector;
-        details::Connector * _right = new details::Connector;
-        Type *_ptr = nullptr;
+        static_assert(!(std::is_array_v<Type> && details::is_single_object_v<Deleter>),
+                      "this deleter frees single objects only; linked_ptr<T[]> needs delete[]");
+
+        element_type *_ptr = nullptr;
+
+        details::Connector &connector() const noexcept {
+            return const_cast<linked_ptr &>(*this);
+        }
 
         void clear() {
-            if (unique()) {
-                static_assert(sizeof(Type) > 0, "incomplete type" );
-                delete _ptr;
+            if constexpr (details::is_abandonable_v<Deleter>) {
+                if (_ptr && deleter().abandon()) {
+                    abandon();
+                    return;
+                }
+            }
+
+            if (release() && _ptr) {
+                if constexpr (std::is_same_v<Deleter, std::default_delete<Type>>)
+                    static_assert(sizeof(element_type) > 0, "incomplete type" );
+                deleter()(_ptr);
             }
-            if (_left->_conWith)
-                _left->_conWith->_conWith = _right->_conWith;
-            if (_right->_conWith)
-                _right->_conWith->_conWith = _left->_conWith;
         }
 
-        template<typename _Type>
-        void copy(const linked_ptr<_Type> &l_ptr) {
-            if (_ptr == l_ptr._ptr)
+        template<typename _Type, typename _Deleter>
+        void copy(const linked_ptr<_Type, _Deleter> &l_ptr) {
+            // Equal pointers may still be different rings (aliases), so
+            // only a copy of itself is skipped; others leave and rejoin
+            if (&connector() == &l_ptr.connector())
                 return;
 
             clear();
 
             _ptr = l_ptr._ptr;
+            deleter() = details::convert_deleter<Deleter, _Type>(l_ptr.get_deleter(), l_ptr._ptr);
+            set_extent(l_ptr.extent());
+            if (_ptr)
+                attach(l_ptr.connector());
+        }
 
-            _right->_conWith = l_ptr._right->_conWith;
-            if (_right->_conWith)
-                _right->_conWith->_conWith = _right;
-            _left->_conWith = l_ptr._right;
-            l_ptr._right->_conWith = _left;
+        // Takes a newly adopted object, binding its enable_linked_from_this
+        // anchor if it has one
+        template<typename _Type>
+        void adopt(_Type *ptr) noexcept {
+            _ptr = ptr;
+            if constexpr (!std::is_array_v<Type>)
+                details::bind_from_this(*this, ptr);
+        }
+
+        // Joins the ring of `l_ptr` pointing at `ptr`; stays empty if either is null
+        template<typename _Type, typename _Deleter>
+        void join(const linked_ptr<_Type, _Deleter> &l_ptr, element_type *ptr) noexcept {
+            if (l_ptr._ptr && ptr) {
+                _ptr = ptr;
+                if constexpr (std::is_array_v<Type> && std::is_array_v<_Type>)
+                    set_extent(l_ptr.extent());
+                attach(l_ptr.connector());
+            }
+        }
+
+        template<typename _Type, typename _Deleter>
+        void move(linked_ptr<_Type, _Deleter> &l_ptr) noexcept {
+            _ptr = l_ptr._ptr;
+            l_ptr._ptr = nullptr;
+            set_extent(l_ptr.extent());
+            l_ptr.set_extent(0);
+            take(l_ptr);
         }
 
+        template<typename _Type, typename _Deleter>
+        static constexpr bool is_compatible_v =
+                std::is_convertible_v<_Type *, Type *> && details::is_deleter_convertible_v<_Deleter, Deleter, _Type>;
+
+        // Raw `_Type *` may be adopted: derived objects for single objects,
+        // only (less cv-qualified) element pointers for arrays
+        template<typename _Type>
+        static constexpr bool is_adoptable_v =
+                std::is_convertible_v<details::owned_t<Type, _Type> *, Type *>;
+
     public:
         constexpr linked_ptr(std::nullptr_t) : linked_ptr() {}
 
@@ -61,115 +819,728 @@ namespace smart_ptr {
         template<
                 typename _Type,
                 typename = std::enable_if_t<
-                        std::is_convertible_v<_Type *, Type *>
+                        is_adoptable_v<_Type>
+                >
+        >
+        explicit linked_ptr(_Type *ptr) : holder(details::adopt_deleter<Deleter, details::owned_t<Type, _Type>>(ptr)) {
+            adopt(ptr);
+        }
+
+        template<
+                typename _Type,
+                typename = std::enable_if_t<
+                        is_adoptable_v<_Type>
                 >
         >
-        explicit linked_ptr(_Type *ptr) {
+        linked_ptr(_Type *ptr, Deleter deleter) : holder(std::move(deleter)) {
+            adopt(ptr);
+        }
+
+        // Adopts an array of `size` elements
+        template<
+                typename _Type,
+                typename = std::enable_if_t<
+                        std::is_array_v<Type> && is_adoptable_v<_Type>
+                >
+        >
+        linked_ptr(_Type *ptr, std::size_t size) : holder(details::adopt_deleter<Deleter, _Type[]>(ptr)) {
             _ptr = ptr;
+            set_extent(size);
         }
 
         template<
                 typename _Type,
                 typename = std::enable_if_t<
-                        std::is_convertible_v<_Type *, Type *>
+                        std::is_array_v<Type> && is_adoptable_v<_Type>
                 >
         >
-        linked_ptr(linked_ptr<_Type> &l_ptr) noexcept {
+        linked_ptr(_Type *ptr, std::size_t size, Deleter deleter) : holder(std::move(deleter)) {
+            _ptr = ptr;
+            set_extent(size);
+        }
+
+        linked_ptr(const linked_ptr &l_ptr) noexcept : holder(l_ptr.get_deleter()) {
             copy(l_ptr);
         }
 
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_ptr(const linked_ptr<_Type, _Deleter> &l_ptr) noexcept
+                : holder(details::convert_deleter<Deleter, _Type>(l_ptr.get_deleter(), l_ptr._ptr)) {
+            copy(l_ptr);
+        }
+
+        linked_ptr(linked_ptr &&l_ptr) noexcept : holder(std::move(l_ptr.deleter())) {
+            move(l_ptr);
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_ptr(linked_ptr<_Type, _Deleter> &&l_ptr) noexcept
+                : holder(details::convert_deleter<Deleter, _Type>(std::move(l_ptr.deleter()), l_ptr._ptr)) {
+            move(l_ptr);
+        }
+
+        // Shares ownership of the object of `l_ptr` while pointing at `ptr`,
+        // e.g. one of its members; the last owner still frees the object as
+        // `l_ptr` would. Empty if either is null.
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        std::is_same_v<Deleter, any_deleter> && details::is_aliasable_v<_Deleter>
+                >
+        >
+        linked_ptr(const linked_ptr<_Type, _Deleter> &l_ptr, element_type *ptr) noexcept
+                : holder(details::alias_deleter<_Type>(l_ptr.get_deleter(), l_ptr._ptr)) {
+            join(l_ptr, ptr);
+        }
+
+        // Adopts the object of `u_ptr` together with its deleter; arrays
+        // adopted this way have an unknown size()
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        std::is_convertible_v<_Type *, Type *> &&
+                        (std::is_constructible_v<Deleter, _Deleter &&> ||
+                         details::is_deleter_convertible_v<_Deleter, Deleter, _Type>)
+                >
+        >
+        linked_ptr(std::unique_ptr<_Type, _Deleter> &&u_ptr)
+                : holder(details::convert_deleter<Deleter, _Type>(std::move(u_ptr.get_deleter()), u_ptr.get())) {
+            adopt(u_ptr.release());
+        }
+
+        // Owner of the object observed by `w_ptr`; empty once it expired
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        explicit linked_ptr(const linked_weak_ptr<_Type, _Deleter> &w_ptr) noexcept
+                : holder(details::convert_deleter<Deleter, _Type>(w_ptr.deleter(), w_ptr._ptr)) {
+            if (w_ptr.linked()) {
+                _ptr = w_ptr._ptr;
+                set_extent(w_ptr.extent());
+                attach(w_ptr.connector());
+            }
+        }
+
         ~linked_ptr() {
             clear();
-            delete _left;
-            delete _right;
         }
 
-        void reset(Type *ptr = nullptr) noexcept {
+        void reset(element_type *ptr = nullptr) noexcept {
             clear();
-            _ptr = ptr;
-            _left->_conWith = _right->_conWith = nullptr;
+            adopt(ptr);
+            set_extent(0);
+            if constexpr (std::is_same_v<Deleter, any_deleter>)
+                deleter() = any_deleter::owning<Type>(ptr);
+        }
+
+        template<typename _Type, typename = std::enable_if_t<
+                !std::is_same_v<_Type, element_type> && is_adoptable_v<_Type>>>
+        void reset(_Type *ptr) noexcept {
+            clear();
+            adopt(ptr);
+            set_extent(0);
+            if constexpr (std::is_same_v<Deleter, any_deleter>)
+                deleter() = any_deleter::owning<details::owned_t<Type, _Type>>(ptr);
+        }
+
+        void reset(element_type *ptr, Deleter l_deleter) noexcept {
+            clear();
+            adopt(ptr);
+            set_extent(0);
+            deleter() = std::move(l_deleter);
+        }
+
+        template<typename _Type = Type, typename = std::enable_if_t<std::is_array_v<_Type>>>
+        void reset(element_type *ptr, std::size_t size) noexcept {
+            reset(ptr);
+            set_extent(size);
         }
 
-        Type *get() const noexcept {
+        element_type *get() const noexcept {
             return _ptr;
         }
 
-        void swap(linked_ptr<Type> &l_ptr) noexcept {
-            std::swap(_ptr, l_ptr._ptr);
+        Deleter &get_deleter() noexcept {
+            return deleter();
+        }
+
+        const Deleter &get_deleter() const noexcept {
+            return deleter();
+        }
+
+        // Hands the object over to a unique_ptr if this is its only owner;
+        // otherwise returns an empty unique_ptr and leaves *this untouched.
+        std::unique_ptr<Type, Deleter> release_unique() noexcept {
+            if (!_ptr || !release_last())
+                return std::unique_ptr<Type, Deleter>(nullptr, deleter());
+
+            std::unique_ptr<Type, Deleter> u_ptr(_ptr, std::move(deleter()));
+            _ptr = nullptr;
+            set_extent(0);
+            return u_ptr;
+        }
 
-            std::swap(_left, l_ptr._left);
-            std::swap(_right, l_ptr._right);
+        void swap(linked_ptr<Type, Deleter> &l_ptr) noexcept {
+            using std::swap;
+            swap(_ptr, l_ptr._ptr);
+            swap(deleter(), l_ptr.deleter());
+            const std::size_t l_extent = l_ptr.extent();
+            l_ptr.set_extent(extent());
+            set_extent(l_extent);
+            details::Connector::swap(l_ptr);
         }
 
+        // Sole owner, possibly observed by weak members
         bool unique() const noexcept {
-            return (_ptr && !_left->_conWith && !_right->_conWith);
+            return (_ptr && !shared());
         }
 
-        template<typename _Type>
-        inline bool operator==(const linked_ptr<_Type> &l_ptr) const noexcept {
+        // Number of owners of the object. No count is stored anywhere (that
+        // would take a shared block), so this walks the ring: O(ring size).
+        std::size_t use_count() const noexcept {
+            return _ptr ? ring_size() : 0;
+        }
+
+        template<typename _Type, typename _Deleter>
+        inline bool operator==(const linked_ptr<_Type, _Deleter> &l_ptr) const noexcept {
             return (_ptr == l_ptr._ptr);
         }
 
-        template<typename _Type>
-        inline bool operator!=(const linked_ptr<_Type> &l_ptr) const noexcept {
+        template<typename _Type, typename _Deleter>
+        inline bool operator!=(const linked_ptr<_Type, _Deleter> &l_ptr) const noexcept {
             return (_ptr != l_ptr._ptr);
         }
 
-        template<typename _Type>
-        inline bool operator<(const linked_ptr<_Type> &l_ptr) const noexcept {
+        template<typename _Type, typename _Deleter>
+        inline bool operator<(const linked_ptr<_Type, _Deleter> &l_ptr) const noexcept {
             return (_ptr < l_ptr._ptr);
         }
 
-        template<typename _Type>
-        inline bool operator>(const linked_ptr<_Type> &l_ptr) const noexcept {
+        template<typename _Type, typename _Deleter>
+        inline bool operator>(const linked_ptr<_Type, _Deleter> &l_ptr) const noexcept {
             return (_ptr > l_ptr._ptr);
         }
 
-        template<typename _Type>
-        inline bool operator<=(const linked_ptr<_Type> &l_ptr) const noexcept {
+        template<typename _Type, typename _Deleter>
+        inline bool operator<=(const linked_ptr<_Type, _Deleter> &l_ptr) const noexcept {
             return (_ptr <= l_ptr._ptr);
         }
 
-        template<typename _Type>
-        inline bool operator>=(const linked_ptr<_Type> &l_ptr) const noexcept {
+        template<typename _Type, typename _Deleter>
+        inline bool operator>=(const linked_ptr<_Type, _Deleter> &l_ptr) const noexcept {
             return (_ptr >= l_ptr._ptr);
         }
 
+        linked_ptr<Type, Deleter>& operator=(const linked_ptr<Type, Deleter> &l_ptr) noexcept {
+            copy(l_ptr);
+            return *this;
+        }
+
         template<
                 typename _Type,
+                typename _Deleter,
                 typename = std::enable_if_t<
-                        std::is_convertible_v<_Type *, Type *>
+                        is_compatible_v<_Type, _Deleter>
                 >
         >
-        linked_ptr<Type>& operator=(linked_ptr<_Type> &l_ptr) noexcept {
+        linked_ptr<Type, Deleter>& operator=(const linked_ptr<_Type, _Deleter> &l_ptr) noexcept {
             copy(l_ptr);
             return *this;
         }
 
+        // The source is taken over before the old object is released, which
+        // may own it (e.g. `head = std::move(head->next)`)
+        linked_ptr<Type, Deleter>& operator=(linked_ptr<Type, Deleter> &&l_ptr) noexcept {
+            if (this != &l_ptr) {
+                linked_ptr tmp(std::move(l_ptr));
+                swap(tmp);
+            }
+            return *this;
+        }
+
         template<
                 typename _Type,
+                typename _Deleter,
                 typename = std::enable_if_t<
-                        std::is_convertible_v<_Type *, Type *>
+                        is_compatible_v<_Type, _Deleter>
                 >
         >
-        linked_ptr<Type>& operator=(const linked_ptr<_Type> &l_ptr) noexcept {
-            copy(l_ptr);
+        linked_ptr<Type, Deleter>& operator=(linked_ptr<_Type, _Deleter> &&l_ptr) noexcept {
+            linked_ptr tmp(std::move(l_ptr));
+            swap(tmp);
+            return *this;
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        std::is_convertible_v<_Type *, Type *> &&
+                        (std::is_constructible_v<Deleter, _Deleter &&> ||
+                         details::is_deleter_convertible_v<_Deleter, Deleter, _Type>)
+                >
+        >
+        linked_ptr<Type, Deleter>& operator=(std::unique_ptr<_Type, _Deleter> &&u_ptr) {
+            // `u_ptr` may be owned by the old object, so empty it before reset()
+            Deleter l_deleter = details::convert_deleter<Deleter, _Type>(std::move(u_ptr.get_deleter()), u_ptr.get());
+            auto ptr = u_ptr.release();
+            reset(ptr, std::move(l_deleter));
             return *this;
         }
 
-        Type &operator*() const noexcept {
+        template<typename _Type = Type, typename = std::enable_if_t<!std::is_array_v<_Type>>>
+        _Type &operator*() const noexcept {
             return *_ptr;
         }
 
-        Type *operator->() const noexcept {
+        template<typename _Type = Type, typename = std::enable_if_t<!std::is_array_v<_Type>>>
+        _Type *operator->() const noexcept {
             return _ptr;
         }
 
+        template<typename _Type = Type, typename = std::enable_if_t<std::is_array_v<_Type>>>
+        element_type &operator[](std::size_t i) const noexcept {
+            return _ptr[i];
+        }
+
+        // Number of elements of an array; 0 when it was adopted without one
+        template<typename _Type = Type, typename = std::enable_if_t<std::is_array_v<_Type>>>
+        std::size_t size() const noexcept {
+            return extent();
+        }
+
+        template<typename _Type = Type, typename = std::enable_if_t<std::is_array_v<_Type>>>
+        element_type *begin() const noexcept {
+            return _ptr;
+        }
+
+        template<typename _Type = Type, typename = std::enable_if_t<std::is_array_v<_Type>>>
+        element_type *end() const noexcept {
+            return _ptr + extent();
+        }
+
+#if __cplusplus >= 202002L
+        template<typename _Type = Type, typename = std::enable_if_t<std::is_array_v<_Type>>>
+        std::span<element_type> span() const noexcept {
+            return std::span<element_type>(_ptr, extent());
+        }
+#endif
+
         inline explicit operator bool() const noexcept {
             return (_ptr != nullptr);
         }
     };
+
+    // Non-owning member of a linked_ptr ring. It never keeps the object
+    // alive: the last owner detaches every weak member before deleting it,
+    // after which they are expired and lock() yields an empty linked_ptr.
+    // No counter block outlives the object.
+    template<typename Type, typename Deleter>
+    class linked_weak_ptr : private details::Connector, private details::DeleterHolder<Deleter>,
+                            private details::ExtentHolder<std::is_array_v<Type>> {
+        template<typename _Type, typename _Deleter>
+        friend
+        class linked_ptr;
+
+        template<typename _Type, typename _Deleter>
+        friend
+        class linked_weak_ptr;
+
+        friend struct details::RingAccess;
+
+        using holder = details::DeleterHolder<Deleter>;
+        using holder::deleter;
+
+        using extent_holder = details::ExtentHolder<std::is_array_v<Type>>;
+        using extent_holder::extent;
+        using extent_holder::set_extent;
+
+    public:
+        using element_type = std::remove_extent_t<Type>;
+        using deleter_type = Deleter;
+
+    private:
+#ifdef SMART_PTR_LINKED_PTR_MT
+        static_assert(details::always_false_v<Type>,
+                      "linked_weak_ptr is not supported with SMART_PTR_LINKED_PTR_MT: "
+                      "expiring weak members walks the ring past the locked nodes");
+#endif
+
+        // Only meaningful while linked
+        element_type *_ptr = nullptr;
+
+        details::Connector &connector() const noexcept {
+            return const_cast<linked_weak_ptr &>(*this);
+        }
+
+        // Joins the ring of `con` (a live owner or observer of `ptr`)
+        void join(element_type *ptr, std::size_t size, details::Connector &con) noexcept {
+            _ptr = ptr;
+            set_extent(size);
+            attach(con);
+        }
+
+        void unlink() noexcept {
+            if constexpr (details::is_abandonable_v<Deleter>) {
+                if (linked() && deleter().abandon()) {
+                    abandon();
+                    return;
+                }
+            }
+            detach();
+        }
+
+        template<typename _Type, typename _Deleter>
+        void move(linked_weak_ptr<_Type, _Deleter> &w_ptr) noexcept {
+            _ptr = w_ptr._ptr;
+            set_extent(w_ptr.extent());
+            take(w_ptr);
+        }
+
+        template<typename _Type, typename _Deleter>
+        static constexpr bool is_compatible_v =
+                std::is_convertible_v<_Type *, Type *> && details::is_deleter_convertible_v<_Deleter, Deleter, _Type>;
+
+    public:
+        linked_weak_ptr() noexcept {
+            make_weak();
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_weak_ptr(const linked_ptr<_Type, _Deleter> &l_ptr) noexcept
+                : holder(details::convert_deleter<Deleter, _Type>(l_ptr.get_deleter(), l_ptr._ptr)) {
+            make_weak();
+            if (l_ptr._ptr)
+                join(l_ptr._ptr, l_ptr.extent(), l_ptr.connector());
+        }
+
+        linked_weak_ptr(const linked_weak_ptr &w_ptr) noexcept : holder(w_ptr.deleter()) {
+            make_weak();
+            if (w_ptr.linked())
+                join(w_ptr._ptr, w_ptr.extent(), w_ptr.connector());
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_weak_ptr(const linked_weak_ptr<_Type, _Deleter> &w_ptr) noexcept
+                : holder(details::convert_deleter<Deleter, _Type>(w_ptr.deleter(), w_ptr._ptr)) {
+            make_weak();
+            if (w_ptr.linked())
+                join(w_ptr._ptr, w_ptr.extent(), w_ptr.connector());
+        }
+
+        linked_weak_ptr(linked_weak_ptr &&w_ptr) noexcept : holder(std::move(w_ptr.deleter())) {
+            make_weak();
+            move(w_ptr);
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_weak_ptr(linked_weak_ptr<_Type, _Deleter> &&w_ptr) noexcept
+                : holder(details::convert_deleter<Deleter, _Type>(std::move(w_ptr.deleter()), w_ptr._ptr)) {
+            make_weak();
+            move(w_ptr);
+        }
+
+        ~linked_weak_ptr() {
+            unlink();
+        }
+
+        void reset() noexcept {
+            unlink();
+            _ptr = nullptr;
+            set_extent(0);
+        }
+
+        void swap(linked_weak_ptr<Type, Deleter> &w_ptr) noexcept {
+            using std::swap;
+            swap(_ptr, w_ptr._ptr);
+            swap(deleter(), w_ptr.deleter());
+            const std::size_t w_extent = w_ptr.extent();
+            w_ptr.set_extent(extent());
+            set_extent(w_extent);
+            details::Connector::swap(w_ptr);
+        }
+
+        bool expired() const noexcept {
+            return !linked();
+        }
+
+        // Number of owners of the observed object; O(ring size)
+        std::size_t use_count() const noexcept {
+            return linked() ? ring_size() : 0;
+        }
+
+        linked_ptr<Type, Deleter> lock() const noexcept {
+            return linked_ptr<Type, Deleter>(*this);
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_weak_ptr<Type, Deleter>& operator=(const linked_ptr<_Type, _Deleter> &l_ptr) noexcept {
+            reset();
+            deleter() = details::convert_deleter<Deleter, _Type>(l_ptr.get_deleter(), l_ptr._ptr);
+            if (l_ptr._ptr)
+                join(l_ptr._ptr, l_ptr.extent(), l_ptr.connector());
+            return *this;
+        }
+
+        linked_weak_ptr<Type, Deleter>& operator=(const linked_weak_ptr<Type, Deleter> &w_ptr) noexcept {
+            if (this != &w_ptr) {
+                reset();
+                deleter() = w_ptr.deleter();
+                if (w_ptr.linked())
+                    join(w_ptr._ptr, w_ptr.extent(), w_ptr.connector());
+            }
+            return *this;
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_weak_ptr<Type, Deleter>& operator=(const linked_weak_ptr<_Type, _Deleter> &w_ptr) noexcept {
+            reset();
+            deleter() = details::convert_deleter<Deleter, _Type>(w_ptr.deleter(), w_ptr._ptr);
+            if (w_ptr.linked())
+                join(w_ptr._ptr, w_ptr.extent(), w_ptr.connector());
+            return *this;
+        }
+
+        linked_weak_ptr<Type, Deleter>& operator=(linked_weak_ptr<Type, Deleter> &&w_ptr) noexcept {
+            if (this != &w_ptr) {
+                reset();
+                deleter() = std::move(w_ptr.deleter());
+                move(w_ptr);
+            }
+            return *this;
+        }
+
+        template<
+                typename _Type,
+                typename _Deleter,
+                typename = std::enable_if_t<
+                        is_compatible_v<_Type, _Deleter>
+                >
+        >
+        linked_weak_ptr<Type, Deleter>& operator=(linked_weak_ptr<_Type, _Deleter> &&w_ptr) noexcept {
+            reset();
+            deleter() = details::convert_deleter<Deleter, _Type>(std::move(w_ptr.deleter()), w_ptr._ptr);
+            move(w_ptr);
+            return *this;
+        }
+    };
+
+    // Base of objects that can produce owning handles to themselves. The
+    // first linked_ptr adopting the object stores a weak anchor into its
+    // ring, so linked_from_this() splices a new owner in O(1). Returns an
+    // empty linked_ptr while the object has no owner.
+    template<typename Type, typename Deleter>
+    class enable_linked_from_this {
+        template<typename Owner, typename _Type, typename _Deleter>
+        friend void details::bind_from_this(const Owner &owner,
+                                            const enable_linked_from_this<_Type, _Deleter> *ptr) noexcept;
+
+        mutable linked_weak_ptr<Type, Deleter> _weak_this;
+
+    protected:
+        enable_linked_from_this() noexcept = default;
+
+        // Copies are distinct objects with owners of their own
+        enable_linked_from_this(const enable_linked_from_this &) noexcept {}
+
+        enable_linked_from_this &operator=(const enable_linked_from_this &) noexcept {
+            return *this;
+        }
+
+        ~enable_linked_from_this() = default;
+
+    public:
+        linked_ptr<Type, Deleter> linked_from_this() {
+            return _weak_this.lock();
+        }
+
+        linked_weak_ptr<Type, Deleter> weak_from_this() noexcept {
+            return _weak_this;
+        }
+    };
+
+    namespace details {
+        template<typename Owner>
+        void bind_from_this(const Owner &, const volatile void *) noexcept {}
+
+        template<typename Owner, typename Type, typename Deleter>
+        void bind_from_this(const Owner &owner, const enable_linked_from_this<Type, Deleter> *ptr) noexcept {
+            static_assert(std::is_constructible_v<linked_weak_ptr<Type, Deleter>, const Owner &>,
+                          "enable_linked_from_this<T, D> objects must be owned with a deleter convertible to D");
+            if (ptr && ptr->_weak_this.expired())
+                ptr->_weak_this = owner;
+        }
+    }
+
+    namespace details {
+        struct PointerCast {
+            // linked_ptr<Type, Deleter> joining the ring of `l_ptr` at `ptr`
+            template<typename Type, typename Deleter, typename _Type, typename _Deleter>
+            static linked_ptr<Type, Deleter> join(const linked_ptr<_Type, _Deleter> &l_ptr,
+                                                  std::remove_extent_t<Type> *ptr) noexcept {
+                linked_ptr<Type, Deleter> cast;
+                if constexpr (std::is_same_v<Deleter, any_deleter>)
+                    cast.deleter() = alias_deleter<_Type>(l_ptr.get_deleter(), l_ptr._ptr);
+                cast.join(l_ptr, ptr);
+                return cast;
+            }
+        };
+    }
+
+    // Casts sharing ownership with `l_ptr`: the result joins its ring, so
+    // nothing is allocated. default_delete is rebound to the target type,
+    // other deleters become an any_deleter of the original object.
+    template<typename Type, typename _Type, typename _Deleter>
+    linked_ptr<Type, details::rebind_deleter_t<_Deleter, Type>>
+    static_pointer_cast(const linked_ptr<_Type, _Deleter> &l_ptr) noexcept {
+        return details::PointerCast::join<Type, details::rebind_deleter_t<_Deleter, Type>>(
+                l_ptr, static_cast<std::remove_extent_t<Type> *>(l_ptr.get()));
+    }
+
+    // Empty if the object is not a Type
+    template<typename Type, typename _Type, typename _Deleter>
+    linked_ptr<Type, details::rebind_deleter_t<_Deleter, Type>>
+    dynamic_pointer_cast(const linked_ptr<_Type, _Deleter> &l_ptr) noexcept {
+        return details::PointerCast::join<Type, details::rebind_deleter_t<_Deleter, Type>>(
+                l_ptr, dynamic_cast<std::remove_extent_t<Type> *>(l_ptr.get()));
+    }
+
+    template<typename Type, typename _Type, typename _Deleter>
+    linked_ptr<Type, details::rebind_deleter_t<_Deleter, Type>>
+    const_pointer_cast(const linked_ptr<_Type, _Deleter> &l_ptr) noexcept {
+        return details::PointerCast::join<Type, details::rebind_deleter_t<_Deleter, Type>>(
+                l_ptr, const_cast<std::remove_extent_t<Type> *>(l_ptr.get()));
+    }
+
+    // Moves [first, last) into uninitialized storage at `dest` (which must
+    // not overlap it); the source storage is left dead, without running
+    // destructors. The block is copied at once and only links pointing into
+    // it or out of it are repaired, in a single pass.
+    template<typename Type, typename Deleter>
+    void relocate(linked_ptr<Type, Deleter> *first, linked_ptr<Type, Deleter> *last,
+                  linked_ptr<Type, Deleter> *dest) noexcept {
+        if constexpr (!std::is_trivially_copyable_v<Deleter>) {
+            for (; first != last; ++first, ++dest) {
+                ::new (static_cast<void *>(dest)) linked_ptr<Type, Deleter>(std::move(*first));
+                first->~linked_ptr();
+            }
+        } else {
+            if (first == last)
+                return;
+
+            const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(first);
+            const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(last);
+            const std::uintptr_t shift = reinterpret_cast<std::uintptr_t>(dest) - begin;
+
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), end - begin);
+            for (linked_ptr<Type, Deleter> *it = dest; it != dest + (last - first); ++it)
+                static_cast<details::Connector &>(*it).relocated(begin, end, shift);
+        }
+    }
+
+    // Creates the first owner of a new object. The ring links live inside
+    // the linked_ptr, so this costs exactly one allocation for the object.
+    template<typename Type, typename... Args>
+    linked_ptr<Type> make_linked(Args &&... args) {
+        return linked_ptr<Type>(new Type(std::forward<Args>(args)...));
+    }
+
+    // Creates the first owner of `size` value-initialized elements
+    template<typename Type>
+    linked_ptr<Type[]> make_linked_array(std::size_t size) {
+        return linked_ptr<Type[]>(new Type[size](), size);
+    }
+
+    // Same, but default-initialized: trivial elements are left
+    // uninitialized, for buffers that are written before being read.
+    template<typename Type>
+    linked_ptr<Type[]> make_linked_array_for_overwrite(std::size_t size) {
+        return linked_ptr<Type[]>(new Type[size], size);
+    }
+
+    // Creates an owner whose object is allocated and later freed through
+    // `alloc` (rebound to Type), e.g. a per-request pool or arena.
+    template<typename Type, typename Alloc, typename... Args>
+    linked_ptr<
+            Type,
+            allocator_delete<typename std::allocator_traits<Alloc>::template rebind_alloc<Type>>
+    > allocate_linked(const Alloc &alloc, Args &&... args) {
+        using alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Type>;
+        using traits = std::allocator_traits<alloc_type>;
+
+        alloc_type type_alloc(alloc);
+        Type *ptr = traits::allocate(type_alloc, 1);
+        try {
+            traits::construct(type_alloc, ptr, std::forward<Args>(args)...);
+        } catch (...) {
+            traits::deallocate(type_alloc, ptr, 1);
+            throw;
+        }
+        return linked_ptr<Type, allocator_delete<alloc_type>>(ptr, allocator_delete<alloc_type>(type_alloc));
+    }
+
+    namespace pmr {
+        template<typename Type>
+        using linked_ptr = smart_ptr::linked_ptr<
+                Type,
+                allocator_delete<std::pmr::polymorphic_allocator<Type>>
+        >;
+
+        template<typename Type, typename... Args>
+        linked_ptr<Type> allocate_linked(std::pmr::memory_resource *resource, Args &&... args) {
+            return smart_ptr::allocate_linked<Type>(
+                    std::pmr::polymorphic_allocator<Type>(resource), std::forward<Args>(args)...);
+        }
+    }
+SMART_PTR_END_MODE
 }
 
 #endif //_SMART_PTR_LINKED_PTR_HPP
-
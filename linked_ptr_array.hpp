@@ -0,0 +1,149 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_LINKED_PTR_ARRAY_HPP
+#define _SMART_PTR_LINKED_PTR_ARRAY_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    // Structure-of-arrays container of shared handles. Raw pointers are kept
+    // in one contiguous array, so scans never touch ownership data. Elements
+    // sharing an object form a group; a group holds one linked_ptr that is
+    // a regular member of the object's ring, so elements interoperate with
+    // linked_ptr handles outside the container.
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class linked_ptr_array {
+        static constexpr std::uint32_t npos = UINT32_MAX;
+
+        struct Group {
+            linked_ptr<Type, Deleter> _anchor;
+            std::uint32_t _size = 0;  // next free group while unused
+        };
+
+    private:
+        std::vector<Type *> _ptrs;
+        std::vector<std::uint32_t> _group;
+        std::vector<Group> _groups;
+        std::uint32_t _free = npos;
+
+        std::uint32_t open_group(const linked_ptr<Type, Deleter> &l_ptr) {
+            std::uint32_t index = _free;
+            if (index != npos) {
+                _free = _groups[index]._size;
+            } else {
+                index = static_cast<std::uint32_t>(_groups.size());
+                _groups.emplace_back();
+            }
+            _groups[index]._anchor = l_ptr;
+            _groups[index]._size = 0;
+            return index;
+        }
+
+        void leave_group(std::uint32_t index) {
+            if (index == npos || --_groups[index]._size)
+                return;
+
+            _groups[index]._anchor.reset();
+            _groups[index]._size = _free;
+            _free = index;
+        }
+
+        void push(Type *ptr, std::uint32_t group) {
+            _ptrs.push_back(ptr);
+            _group.push_back(group);
+            if (group != npos)
+                ++_groups[group]._size;
+        }
+
+    public:
+        linked_ptr_array() = default;
+
+        ~linked_ptr_array() = default;
+
+        std::size_t size() const noexcept {
+            return _ptrs.size();
+        }
+
+        bool empty() const noexcept {
+            return _ptrs.empty();
+        }
+
+        void reserve(std::size_t size) {
+            _ptrs.reserve(size);
+            _group.reserve(size);
+        }
+
+        // Contiguous raw pointers, valid until the next modification
+        Type *const *data() const noexcept {
+            return _ptrs.data();
+        }
+
+        Type *operator[](std::size_t index) const noexcept {
+            return _ptrs[index];
+        }
+
+        bool unique(std::size_t index) const noexcept {
+            std::uint32_t group = _group[index];
+            return (group != npos && _groups[group]._size == 1 && _groups[group]._anchor.unique());
+        }
+
+        // Takes ownership of `ptr`, like linked_ptr(ptr)
+        void push_back(Type *ptr) {
+            push_back(linked_ptr<Type, Deleter>(ptr));
+        }
+
+        // Copy-in: the new element shares ownership with `l_ptr`
+        void push_back(const linked_ptr<Type, Deleter> &l_ptr) {
+            if (!l_ptr) {
+                push(nullptr, npos);
+                return;
+            }
+
+            _ptrs.reserve(_ptrs.size() + 1);
+            _group.reserve(_group.size() + 1);
+            push(l_ptr.get(), open_group(l_ptr));
+        }
+
+        // Appends a copy of element `index`
+        void push_back_copy(std::size_t index) {
+            push(_ptrs[index], _group[index]);
+        }
+
+        // Copy-out: a linked_ptr sharing ownership with element `index`
+        linked_ptr<Type, Deleter> share(std::size_t index) const {
+            std::uint32_t group = _group[index];
+            return group != npos ? _groups[group]._anchor : linked_ptr<Type, Deleter>();
+        }
+
+        // Removes element `index`, moving the last element into its place
+        void erase(std::size_t index) {
+            std::uint32_t group = _group[index];
+
+            _ptrs[index] = _ptrs.back();
+            _group[index] = _group.back();
+            _ptrs.pop_back();
+            _group.pop_back();
+
+            leave_group(group);
+        }
+
+        void pop_back() {
+            erase(_ptrs.size() - 1);
+        }
+
+        void clear() {
+            _ptrs.clear();
+            _group.clear();
+            _groups.clear();
+            _free = npos;
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_PTR_ARRAY_HPP
@@ -0,0 +1,275 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_LINKED_PTR_BULK_HPP
+#define _SMART_PTR_LINKED_PTR_BULK_HPP
+
+// Bulk queries over contiguous ranges of linked_ptr. Masks are written as
+// 64-bit words, bit i of word i / 64 describing element i; the caller
+// provides (count + 63) / 64 words. Keys and gathered pointers are
+// element pointers, so linked_ptr<T[]> ranges work as well. AVX2 or SSE2 kernels are selected at
+// compile time, otherwise scalar loops are used.
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    namespace details {
+        struct BulkAccess {
+            template<typename Type, typename Deleter>
+            static typename linked_ptr<Type, Deleter>::element_type *ptr(const linked_ptr<Type, Deleter> &l_ptr) noexcept {
+                return l_ptr._ptr;
+            }
+
+            // Byte offsets of the raw pointer and of the two links
+            template<typename Type, typename Deleter>
+            static void layout(const linked_ptr<Type, Deleter> &l_ptr,
+                               std::size_t &ptr, std::size_t &left, std::size_t &right) noexcept {
+                const char *base = reinterpret_cast<const char *>(&l_ptr);
+                const Connector &con = l_ptr;
+                ptr = reinterpret_cast<const char *>(&l_ptr._ptr) - base;
+                left = reinterpret_cast<const char *>(&con._left) - base;
+                right = reinterpret_cast<const char *>(&con._right) - base;
+            }
+        };
+
+        struct BulkLayout {
+            const char *base;
+            std::size_t stride;
+            std::size_t ptr;
+            std::size_t left;
+            std::size_t right;
+
+            template<typename Type, typename Deleter>
+            explicit BulkLayout(const linked_ptr<Type, Deleter> *first) noexcept
+                    : base(reinterpret_cast<const char *>(first)), stride(sizeof(*first)) {
+                BulkAccess::layout(*first, ptr, left, right);
+            }
+        };
+
+#if defined(__AVX2__)
+        constexpr std::size_t bulk_lanes = 4;
+
+        using lanes_t = __m256i;
+
+        // Loads one pointer-sized field of elements [i, i + 4)
+        inline lanes_t load_lanes(const BulkLayout &layout, std::size_t i, std::size_t field) noexcept {
+            const long long stride = static_cast<long long>(layout.stride);
+            const __m256i index = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+            return _mm256_i64gather_epi64(
+                    reinterpret_cast<const long long *>(layout.base + i * layout.stride + field), index, 1);
+        }
+
+        inline lanes_t broadcast(const void *value) noexcept {
+            return _mm256_set1_epi64x(reinterpret_cast<long long>(value));
+        }
+
+        inline unsigned lanes_mask(lanes_t lanes) noexcept {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(lanes)));
+        }
+
+        inline lanes_t lanes_equal(lanes_t a, lanes_t b) noexcept {
+            return _mm256_cmpeq_epi64(a, b);
+        }
+
+        inline lanes_t lanes_or(lanes_t a, lanes_t b) noexcept {
+            return _mm256_or_si256(a, b);
+        }
+
+        inline lanes_t lanes_andnot(lanes_t a, lanes_t b) noexcept {
+            return _mm256_andnot_si256(a, b);
+        }
+
+        inline lanes_t lanes_zero() noexcept {
+            return _mm256_setzero_si256();
+        }
+#elif defined(__SSE2__)
+        constexpr std::size_t bulk_lanes = 2;
+
+        using lanes_t = __m128i;
+
+        // Loads one pointer-sized field of elements [i, i + 2)
+        inline lanes_t load_lanes(const BulkLayout &layout, std::size_t i, std::size_t field) noexcept {
+            const char *at = layout.base + i * layout.stride + field;
+            long long lo, hi;
+            std::memcpy(&lo, at, sizeof(lo));
+            std::memcpy(&hi, at + layout.stride, sizeof(hi));
+            return _mm_set_epi64x(hi, lo);
+        }
+
+        inline lanes_t broadcast(const void *value) noexcept {
+            return _mm_set1_epi64x(reinterpret_cast<long long>(value));
+        }
+
+        inline unsigned lanes_mask(lanes_t lanes) noexcept {
+            return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(lanes)));
+        }
+
+        // 64-bit equality out of 32-bit compares (SSE2 has no pcmpeqq)
+        inline lanes_t lanes_equal(lanes_t a, lanes_t b) noexcept {
+            __m128i eq = _mm_cmpeq_epi32(a, b);
+            return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+
+        inline lanes_t lanes_or(lanes_t a, lanes_t b) noexcept {
+            return _mm_or_si128(a, b);
+        }
+
+        inline lanes_t lanes_andnot(lanes_t a, lanes_t b) noexcept {
+            return _mm_andnot_si128(a, b);
+        }
+
+        inline lanes_t lanes_zero() noexcept {
+            return _mm_setzero_si128();
+        }
+#else
+        constexpr std::size_t bulk_lanes = 1;
+#endif
+
+        // Fills `mask` word by word: `vector(i)` yields bulk_lanes bits for
+        // elements starting at i, `scalar(i)` handles the tail of a word.
+        template<typename Vector, typename Scalar>
+        void build_mask(std::size_t count, std::uint64_t *mask, Vector vector, Scalar scalar) noexcept {
+            for (std::size_t first = 0; first < count; first += 64) {
+                const std::size_t last = count - first < 64 ? count : first + 64;
+                std::uint64_t word = 0;
+                std::size_t i = first;
+                if constexpr (bulk_lanes > 1) {
+                    for (; last - i >= bulk_lanes; i += bulk_lanes)
+                        word |= static_cast<std::uint64_t>(vector(i)) << (i - first);
+                }
+                for (; i < last; ++i)
+                    word |= static_cast<std::uint64_t>(scalar(i)) << (i - first);
+                mask[first / 64] = word;
+            }
+        }
+    }
+
+    namespace bulk {
+
+        template<typename Type, typename Deleter>
+        void null_mask(const linked_ptr<Type, Deleter> *first, std::size_t count, std::uint64_t *mask) noexcept {
+            if (!count)
+                return;
+
+            [[maybe_unused]] const details::BulkLayout layout(first);
+            details::build_mask(count, mask,
+                    [&](std::size_t i) {
+#if defined(__AVX2__) || defined(__SSE2__)
+                        using namespace details;
+                        return lanes_mask(lanes_equal(load_lanes(layout, i, layout.ptr), lanes_zero()));
+#else
+                        return !details::BulkAccess::ptr(first[i]);
+#endif
+                    },
+                    [&](std::size_t i) { return !details::BulkAccess::ptr(first[i]); });
+        }
+
+        template<typename Type, typename Deleter>
+        void unique_mask(const linked_ptr<Type, Deleter> *first, std::size_t count, std::uint64_t *mask) noexcept {
+            if (!count)
+                return;
+
+            [[maybe_unused]] const details::BulkLayout layout(first);
+            details::build_mask(count, mask,
+                    [&](std::size_t i) {
+#if defined(__AVX2__) || defined(__SSE2__)
+                        using namespace details;
+                        lanes_t links = lanes_or(load_lanes(layout, i, layout.left), load_lanes(layout, i, layout.right));
+                        lanes_t null = lanes_equal(load_lanes(layout, i, layout.ptr), lanes_zero());
+                        lanes_t unlinked = lanes_equal(links, lanes_zero());
+                        unsigned bits = lanes_mask(lanes_andnot(null, unlinked));
+                        // Linked owners may still be unique among weak observers
+                        unsigned linked = ~lanes_mask(lanes_or(null, unlinked)) & ((1u << bulk_lanes) - 1);
+                        for (; linked; linked &= linked - 1) {
+                            const unsigned lane = static_cast<unsigned>(__builtin_ctz(linked));
+                            bits |= static_cast<unsigned>(first[i + lane].unique()) << lane;
+                        }
+                        return bits;
+#else
+                        return first[i].unique();
+#endif
+                    },
+                    [&](std::size_t i) { return first[i].unique(); });
+        }
+
+        // Compares every raw pointer with `key`
+        template<typename Type, typename Deleter>
+        void equal_mask(const linked_ptr<Type, Deleter> *first, std::size_t count,
+                        const typename linked_ptr<Type, Deleter>::element_type *key, std::uint64_t *mask) noexcept {
+            if (!count)
+                return;
+
+            [[maybe_unused]] const details::BulkLayout layout(first);
+            details::build_mask(count, mask,
+                    [&](std::size_t i) {
+#if defined(__AVX2__) || defined(__SSE2__)
+                        using namespace details;
+                        return lanes_mask(lanes_equal(load_lanes(layout, i, layout.ptr), broadcast(key)));
+#else
+                        return details::BulkAccess::ptr(first[i]) == key;
+#endif
+                    },
+                    [&](std::size_t i) { return details::BulkAccess::ptr(first[i]) == key; });
+        }
+
+        // Marks elements whose raw pointer is less than `key`
+        template<typename Type, typename Deleter>
+        void less_mask(const linked_ptr<Type, Deleter> *first, std::size_t count,
+                       const typename linked_ptr<Type, Deleter>::element_type *key, std::uint64_t *mask) noexcept {
+            if (!count)
+                return;
+
+            [[maybe_unused]] const details::BulkLayout layout(first);
+            details::build_mask(count, mask,
+                    [&](std::size_t i) {
+#if defined(__AVX2__)
+                        // Unsigned compare through the signed one: flip the sign bits
+                        const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+                        __m256i keys = _mm256_xor_si256(details::broadcast(key), sign);
+                        __m256i ptrs = _mm256_xor_si256(details::load_lanes(layout, i, layout.ptr), sign);
+                        return details::lanes_mask(_mm256_cmpgt_epi64(keys, ptrs));
+#else
+                        // SSE2 has no 64-bit compare, two scalar lanes are cheaper
+                        unsigned bits = 0;
+                        for (std::size_t lane = 0; lane < details::bulk_lanes; ++lane)
+                            bits |= unsigned(details::BulkAccess::ptr(first[i + lane]) < key) << lane;
+                        return bits;
+#endif
+                    },
+                    [&](std::size_t i) { return details::BulkAccess::ptr(first[i]) < key; });
+        }
+
+        // Copies the raw pointers into `out`
+        template<typename Type, typename Deleter>
+        void gather(const linked_ptr<Type, Deleter> *first, std::size_t count,
+                    typename linked_ptr<Type, Deleter>::element_type **out) noexcept {
+            std::size_t i = 0;
+#if defined(__AVX2__)
+            if (count) {
+                const details::BulkLayout layout(first);
+                for (const std::size_t blocks = count - count % 4; i < blocks; i += 4)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                                        details::load_lanes(layout, i, layout.ptr));
+            }
+#endif
+            for (; i < count; ++i)
+                out[i] = details::BulkAccess::ptr(first[i]);
+        }
+
+        inline std::size_t popcount(const std::uint64_t *mask, std::size_t count) noexcept {
+            std::size_t bits = 0;
+            for (std::size_t i = 0; i < (count + 63) / 64; ++i)
+                bits += static_cast<std::size_t>(__builtin_popcountll(mask[i]));
+            return bits;
+        }
+    }
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_PTR_BULK_HPP
@@ -0,0 +1,131 @@
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "linked_epoch.hpp"
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_LINKED_PUBLISHER_HPP
+#define _SMART_PTR_LINKED_PUBLISHER_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    // RCU-style holder of a read-mostly object (configuration and such).
+    // Writers publish() a new linked_ptr; readers take a snapshot, a plain
+    // pointer valid while the snapshot lives, without joining the ring or
+    // writing anything shared. Replaced handles stay in the publisher,
+    // stamped with the domain's epoch, and are released under the writer
+    // mutex by later publish() or synchronize() calls once every reader
+    // that might still see them has moved on. Copies handed out by
+    // current() share a ring with them, so using those on other threads
+    // takes a SMART_PTR_LINKED_PTR_MT build.
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class linked_publisher {
+        struct replaced {
+            linked_ptr<Type, Deleter> version;
+            std::uint64_t epoch;
+        };
+
+        epoch_domain &_domain;
+        std::mutex _write;
+        linked_ptr<Type, Deleter> _current;
+        std::atomic<Type *> _published{nullptr};
+        // Oldest first; guarded by _write
+        std::deque<replaced> _replaced;
+
+        // Releases the replaced versions no reader can see any more
+        void release_passed() noexcept {
+            while (!_replaced.empty() && _domain.passed(_replaced.front().epoch))
+                _replaced.pop_front();
+        }
+
+    public:
+        // Read-side reference to the version current when it was taken
+        class snapshot {
+            epoch_guard _guard;
+            Type *_ptr;
+
+        public:
+            snapshot(epoch_domain::reader &reader, const std::atomic<Type *> &published) noexcept
+                    : _guard(reader), _ptr(published.load(std::memory_order_acquire)) {}
+
+            Type *get() const noexcept {
+                return _ptr;
+            }
+
+            Type &operator*() const noexcept {
+                return *_ptr;
+            }
+
+            Type *operator->() const noexcept {
+                return _ptr;
+            }
+
+            inline explicit operator bool() const noexcept {
+                return (_ptr != nullptr);
+            }
+        };
+
+        explicit linked_publisher(linked_ptr<Type, Deleter> initial = linked_ptr<Type, Deleter>(),
+                                  epoch_domain &domain = epoch_domain::global())
+                : _domain(domain), _current(std::move(initial)), _published(_current.get()) {}
+
+        linked_publisher(const linked_publisher &) = delete;
+
+        linked_publisher &operator=(const linked_publisher &) = delete;
+
+        // Readers must be done with their snapshots
+        ~linked_publisher() = default;
+
+        epoch_domain &domain() const noexcept {
+            return _domain;
+        }
+
+        // `reader` is the calling thread's registration with domain()
+        snapshot read(epoch_domain::reader &reader) const noexcept {
+            return snapshot(reader, _published);
+        }
+
+        // Makes `next` the current version; the previous one is released
+        // after a grace period
+        void publish(linked_ptr<Type, Deleter> next) {
+            std::lock_guard<std::mutex> lock(_write);
+            _published.store(next.get(), std::memory_order_release);
+            _current.swap(next);
+            if (next)
+                _replaced.push_back(replaced{std::move(next), _domain.stamp()});
+            release_passed();
+        }
+
+        // Owning copy of the current version, for writers
+        linked_ptr<Type, Deleter> current() {
+            std::lock_guard<std::mutex> lock(_write);
+            return _current;
+        }
+
+        // Blocks until every version replaced so far by this publisher is
+        // released; other objects retired into domain() are not waited for.
+        // Not while holding a snapshot.
+        void synchronize() {
+            std::unique_lock<std::mutex> lock(_write);
+            if (_replaced.empty())
+                return;
+            const std::uint64_t epoch = _replaced.back().epoch;
+            lock.unlock();
+
+            while (!_domain.passed(epoch))
+                std::this_thread::yield();
+
+            lock.lock();
+            release_passed();
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_PUBLISHER_HPP
@@ -0,0 +1,189 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "linked_ptr.hpp"
+#include "mpsc_queue.hpp"
+
+#ifndef _SMART_PTR_LINKED_RECLAIMER_HPP
+#define _SMART_PTR_LINKED_RECLAIMER_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    // Runs the destructors of retired objects on a background thread, in
+    // batches: the thread releasing the last owner only claims a slot of a
+    // bounded queue allocated up front, so retiring never allocates or
+    // throws. When the queue is full the object is destroyed right away on
+    // the releasing thread instead. The worker sleeps on a condition
+    // variable while the queue is empty. The reclaimer must outlive the
+    // handles that retire into it.
+    class linked_reclaimer {
+        struct retired {
+            void *ptr;
+            void (*dispose)(void *context, void *ptr);
+        };
+
+        details::mpsc_queue<retired> _queue;
+        std::atomic<std::size_t> _pending{0};
+        std::atomic<std::size_t> _reclaimed{0};
+
+        // Consumer side, shared by the worker and drain()
+        std::mutex _reclaim;
+
+        std::mutex _wake;
+        std::condition_variable _wakeup;
+        bool _stop = false;
+        std::thread _thread;
+
+        // Claims and fills the next slot; false if the queue is full
+        bool push(void *ptr, void (*dispose)(void *context, void *ptr)) noexcept {
+            std::size_t count = 1;
+            const std::size_t position = _queue.claim(count);
+            if (!count)
+                return false;
+
+            // Counted before it is published, so reclaim() never sees it uncounted
+            if (!_pending.fetch_add(1, std::memory_order_relaxed))
+                wake();
+
+            _queue.at(position) = retired{ptr, dispose};
+            _queue.publish(position);
+            return true;
+        }
+
+        // Taking the mutex orders the notification after the worker's
+        // check of pending(), so it cannot be lost
+        void wake() noexcept {
+            {
+                std::lock_guard<std::mutex> lock(_wake);
+            }
+            _wakeup.notify_one();
+        }
+
+        // Destroys everything queued so far, oldest first; returns the count
+        std::size_t reclaim() noexcept {
+            std::lock_guard<std::mutex> lock(_reclaim);
+
+            std::size_t count = 0;
+            for (; const retired *front = _queue.front(); ++count) {
+                const retired item = *front;
+                _queue.pop();
+                item.dispose(nullptr, item.ptr);
+            }
+
+            if (count) {
+                _reclaimed.fetch_add(count, std::memory_order_relaxed);
+                _pending.fetch_sub(count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        void run() noexcept {
+            std::unique_lock<std::mutex> lock(_wake);
+            for (;;) {
+                _wakeup.wait(lock, [this] {
+                    return _stop || _pending.load(std::memory_order_relaxed);
+                });
+                if (_stop)
+                    return;
+
+                lock.unlock();
+                // A slot counted but not filled yet is a short wait
+                if (!reclaim())
+                    std::this_thread::yield();
+                lock.lock();
+            }
+        }
+
+    public:
+        // `capacity` (rounded up to a power of two) bounds the objects
+        // waiting for the worker before releases fall back to inline deletes
+        explicit linked_reclaimer(std::size_t capacity = 4096)
+                : _queue(capacity) {
+            _thread = std::thread(&linked_reclaimer::run, this);
+        }
+
+        linked_reclaimer(const linked_reclaimer &) = delete;
+
+        linked_reclaimer &operator=(const linked_reclaimer &) = delete;
+
+        // Stops the thread, then destroys whatever is still queued
+        ~linked_reclaimer() {
+            {
+                std::lock_guard<std::mutex> lock(_wake);
+                _stop = true;
+            }
+            _wakeup.notify_one();
+            _thread.join();
+            drain();
+        }
+
+        std::size_t capacity() const noexcept {
+            return _queue.capacity();
+        }
+
+        // Queues `ptr` for deletion as a Type, or deletes it here if the
+        // queue is full
+        template<typename Type>
+        void retire(Type *ptr) noexcept {
+            if (!push(details::erase_ptr(ptr), &details::delete_owned<Type>))
+                details::delete_owned<Type>(nullptr, details::erase_ptr(ptr));
+        }
+
+        // Blocks until the queue is empty, destroying objects on the calling
+        // thread as well; meant for shutdown and tests.
+        void drain() noexcept {
+            while (_pending.load(std::memory_order_acquire)) {
+                if (!reclaim())
+                    std::this_thread::yield();
+            }
+        }
+
+        // Objects retired but not destroyed yet
+        std::size_t pending() const noexcept {
+            return _pending.load(std::memory_order_acquire);
+        }
+
+        // Objects destroyed by the reclaimer so far (not inline fallbacks)
+        std::size_t reclaimed() const noexcept {
+            return _reclaimed.load(std::memory_order_relaxed);
+        }
+
+        // Process-wide reclaimer of default constructed deferred_delete
+        static linked_reclaimer &global() {
+            static linked_reclaimer reclaimer;
+            return reclaimer;
+        }
+    };
+
+    // Deleter retiring objects into a linked_reclaimer (the global one if
+    // none is given) instead of destroying them on the releasing thread.
+    // Objects are deleted through the handle's type, like default_delete;
+    // linked_ptr<T[]> rejects it at compile time.
+    class deferred_delete {
+        linked_reclaimer *_reclaimer = nullptr;
+
+    public:
+        using single_object = std::true_type;
+
+        constexpr deferred_delete() noexcept = default;
+
+        explicit deferred_delete(linked_reclaimer &reclaimer) noexcept : _reclaimer(&reclaimer) {}
+
+        linked_reclaimer &reclaimer() const {
+            return _reclaimer ? *_reclaimer : linked_reclaimer::global();
+        }
+
+        template<typename Type>
+        void operator()(Type *ptr) const {
+            reclaimer().retire(ptr);
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_RECLAIMER_HPP
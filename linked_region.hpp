@@ -0,0 +1,184 @@
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_LINKED_REGION_HPP
+#define _SMART_PTR_LINKED_REGION_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    class linked_region;
+
+    namespace details {
+        // Region whose objects are being destroyed on this thread
+        inline thread_local linked_region *closing_region = nullptr;
+
+        struct RegionRecord {
+            linked_region *region;
+            // Destroys the object; null once it was destroyed
+            void (*destroy)(RegionRecord *record) noexcept;
+            RegionRecord *next;
+            // Weak anchor in the ring of the object
+            const Connector *ring;
+        };
+
+        struct RingAccess {
+            template<typename Type, typename Deleter>
+            static const Connector &connector(const linked_weak_ptr<Type, Deleter> &w_ptr) noexcept {
+                return w_ptr;
+            }
+
+            // Number of other members of the ring of `con`
+            static std::size_t members(const Connector &con) noexcept {
+                std::size_t count = 0;
+                for (const Connector *node = con.left(); node; node = node->left())
+                    ++count;
+                for (const Connector *node = con.right(); node; node = node->right())
+                    ++count;
+                return count;
+            }
+        };
+    }
+
+    // Deleter of handles created by linked_region::make(). The last owner
+    // destroys the object early; its memory goes with the region.
+    class region_delete {
+        details::RegionRecord *_record = nullptr;
+
+    public:
+        constexpr region_delete() noexcept = default;
+
+        explicit region_delete(details::RegionRecord *record) noexcept : _record(record) {}
+
+        template<typename Type>
+        void operator()(Type *) const noexcept {
+            if (_record && _record->destroy) {
+                _record->destroy(_record);
+                _record->destroy = nullptr;
+            }
+        }
+
+        // True while the region of the object tears it down
+        bool abandon() noexcept;
+    };
+
+    namespace details {
+        template<typename Type>
+        struct RegionObject : RegionRecord {
+            union {
+                Type object;
+            };
+
+            linked_weak_ptr<Type, region_delete> anchor;
+
+            template<typename... Args>
+            explicit RegionObject(linked_region *owner, Args &&... args)
+                    : RegionRecord{owner, &destroy_object, nullptr, nullptr}, object(std::forward<Args>(args)...) {
+                ring = &RingAccess::connector(anchor);
+            }
+
+            // Never run: the region only destroys the object
+            ~RegionObject() {}
+
+            static void destroy_object(RegionRecord *record) noexcept {
+                static_cast<RegionObject *>(record)->object.~Type();
+            }
+        };
+    }
+
+    // Scope owning a request's object graph. Objects made by the region live
+    // in its arena; when it closes, the live ones are destroyed newest first
+    // and the handles of the region met on the way (in those objects) drop
+    // their links without unlinking, then the arena is freed at once.
+    //
+    // Handles must not outlive the region. Debug builds count the members
+    // of live rings that were not torn down with the objects: close()
+    // returns that number and destroying a region with escapes asserts.
+    class linked_region {
+        friend class region_delete;
+
+        std::pmr::monotonic_buffer_resource _arena;
+        details::RegionRecord *_records = nullptr;
+        std::size_t _abandoned = 0;
+
+        std::size_t teardown() noexcept {
+#ifndef NDEBUG
+            std::size_t members = 0;
+            for (const details::RegionRecord *record = _records; record; record = record->next) {
+                if (record->destroy)
+                    members += details::RingAccess::members(*record->ring);
+            }
+            _abandoned = 0;
+#endif
+
+            linked_region *closing = details::closing_region;
+            details::closing_region = this;
+            for (details::RegionRecord *record = _records; record; record = record->next) {
+                if (record->destroy) {
+                    record->destroy(record);
+                    record->destroy = nullptr;
+                }
+            }
+            details::closing_region = closing;
+
+            _records = nullptr;
+            _arena.release();
+
+#ifndef NDEBUG
+            return members - _abandoned;
+#else
+            return 0;
+#endif
+        }
+
+    public:
+        explicit linked_region(std::size_t initial_size = 4096) : _arena(initial_size) {}
+
+        linked_region(const linked_region &) = delete;
+
+        linked_region &operator=(const linked_region &) = delete;
+
+        ~linked_region() {
+            [[maybe_unused]] const std::size_t escaped = teardown();
+            assert(!escaped && "linked_ptr escaped its linked_region");
+        }
+
+        template<typename Type, typename... Args>
+        linked_ptr<Type, region_delete> make(Args &&... args) {
+            using object_type = details::RegionObject<Type>;
+
+            void *memory = _arena.allocate(sizeof(object_type), alignof(object_type));
+            object_type *object = ::new (memory) object_type(this, std::forward<Args>(args)...);
+            object->next = _records;
+            _records = object;
+
+            linked_ptr<Type, region_delete> l_ptr(&object->object, region_delete(object));
+            object->anchor = l_ptr;
+            return l_ptr;
+        }
+
+        // Destroys every live object and frees the arena, returning the
+        // number of handles that escaped (debug builds only). The region
+        // can be reused afterwards.
+        std::size_t close() noexcept {
+            return teardown();
+        }
+    };
+
+    inline bool region_delete::abandon() noexcept {
+        if (!_record || _record->region != details::closing_region)
+            return false;
+#ifndef NDEBUG
+        ++_record->region->_abandoned;
+#endif
+        return true;
+    }
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_REGION_HPP
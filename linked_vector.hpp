@@ -0,0 +1,198 @@
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_LINKED_VECTOR_HPP
+#define _SMART_PTR_LINKED_VECTOR_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    // Vector of linked_ptr that grows with relocate(): the old buffer is
+    // copied in one block and ring links are repaired in one linear pass,
+    // instead of moving the elements one by one.
+    template<typename Type, typename Deleter = std::default_delete<Type>>
+    class linked_vector {
+    public:
+        using value_type = linked_ptr<Type, Deleter>;
+        using iterator = value_type *;
+        using const_iterator = const value_type *;
+
+    private:
+        using allocator = std::allocator<value_type>;
+        using traits = std::allocator_traits<allocator>;
+
+        value_type *_data = nullptr;
+        std::size_t _size = 0;
+        std::size_t _capacity = 0;
+
+        // Allocates twice the capacity, builds the new last element there and
+        // only then relocates the old ones, since `args` may refer to one of
+        // them (v.emplace_back(v[0]))
+        template<typename... Args>
+        value_type &grow_emplace(Args &&... args) {
+            const std::size_t capacity = _capacity ? 2 * _capacity : 8;
+            allocator alloc;
+            value_type *data = traits::allocate(alloc, capacity);
+            value_type *l_ptr;
+            try {
+                l_ptr = ::new (static_cast<void *>(data + _size)) value_type(std::forward<Args>(args)...);
+            } catch (...) {
+                traits::deallocate(alloc, data, capacity);
+                throw;
+            }
+            if (_data) {
+                relocate(_data, _data + _size, data);
+                traits::deallocate(alloc, _data, _capacity);
+            }
+            _data = data;
+            _capacity = capacity;
+            ++_size;
+            return *l_ptr;
+        }
+
+        void release() noexcept {
+            clear();
+            if (_data) {
+                allocator alloc;
+                traits::deallocate(alloc, _data, _capacity);
+            }
+            _data = nullptr;
+            _capacity = 0;
+        }
+
+    public:
+        linked_vector() = default;
+
+        linked_vector(const linked_vector &vector) {
+            reserve(vector._size);
+            for (const value_type &l_ptr : vector)
+                push_back(l_ptr);
+        }
+
+        linked_vector(linked_vector &&vector) noexcept
+                : _data(vector._data), _size(vector._size), _capacity(vector._capacity) {
+            vector._data = nullptr;
+            vector._size = vector._capacity = 0;
+        }
+
+        ~linked_vector() {
+            release();
+        }
+
+        linked_vector &operator=(const linked_vector &vector) {
+            if (this != &vector) {
+                linked_vector copy(vector);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        linked_vector &operator=(linked_vector &&vector) noexcept {
+            if (this != &vector) {
+                release();
+                swap(vector);
+            }
+            return *this;
+        }
+
+        void swap(linked_vector &vector) noexcept {
+            std::swap(_data, vector._data);
+            std::swap(_size, vector._size);
+            std::swap(_capacity, vector._capacity);
+        }
+
+        void reserve(std::size_t capacity) {
+            if (capacity <= _capacity)
+                return;
+
+            allocator alloc;
+            value_type *data = traits::allocate(alloc, capacity);
+            if (_data) {
+                relocate(_data, _data + _size, data);
+                traits::deallocate(alloc, _data, _capacity);
+            }
+            _data = data;
+            _capacity = capacity;
+        }
+
+        template<typename... Args>
+        value_type &emplace_back(Args &&... args) {
+            if (_size == _capacity)
+                return grow_emplace(std::forward<Args>(args)...);
+            value_type *l_ptr = ::new (static_cast<void *>(_data + _size)) value_type(std::forward<Args>(args)...);
+            ++_size;
+            return *l_ptr;
+        }
+
+        void push_back(const value_type &l_ptr) {
+            emplace_back(l_ptr);
+        }
+
+        void push_back(value_type &&l_ptr) {
+            emplace_back(std::move(l_ptr));
+        }
+
+        void pop_back() noexcept {
+            _data[--_size].~value_type();
+        }
+
+        void clear() noexcept {
+            while (_size)
+                pop_back();
+        }
+
+        std::size_t size() const noexcept {
+            return _size;
+        }
+
+        std::size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+        bool empty() const noexcept {
+            return !_size;
+        }
+
+        value_type *data() noexcept {
+            return _data;
+        }
+
+        const value_type *data() const noexcept {
+            return _data;
+        }
+
+        value_type &operator[](std::size_t index) noexcept {
+            return _data[index];
+        }
+
+        const value_type &operator[](std::size_t index) const noexcept {
+            return _data[index];
+        }
+
+        value_type &back() noexcept {
+            return _data[_size - 1];
+        }
+
+        iterator begin() noexcept {
+            return _data;
+        }
+
+        iterator end() noexcept {
+            return _data + _size;
+        }
+
+        const_iterator begin() const noexcept {
+            return _data;
+        }
+
+        const_iterator end() const noexcept {
+            return _data + _size;
+        }
+    };
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_LINKED_VECTOR_HPP
@@ -0,0 +1,117 @@
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "linked_ptr.hpp"
+
+#ifndef _SMART_PTR_MPSC_QUEUE_HPP
+#define _SMART_PTR_MPSC_QUEUE_HPP
+
+namespace smart_ptr {
+SMART_PTR_BEGIN_MODE
+
+    namespace details {
+        constexpr std::size_t cache_line = 64;
+
+        // Smallest power of two >= max(capacity, 2)
+        inline std::size_t queue_capacity(std::size_t capacity) noexcept {
+            std::size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+            return size;
+        }
+
+        // Bounded multi-producer single-consumer queue of Entry, allocated up
+        // front. Every cell carries a sequence number: its position while
+        // free, the position plus one once filled. Producers claim positions
+        // with a CAS on the tail, fill the cells and publish them one by one;
+        // the consumer takes cells in order and hands each back for the
+        // position one lap later. Claiming and publishing never allocate.
+        template<typename Entry>
+        class mpsc_queue {
+            struct cell {
+                std::atomic<std::size_t> sequence;
+                Entry entry;
+            };
+
+            const std::size_t _mask;
+            const std::unique_ptr<cell[]> _cells;
+            alignas(cache_line) std::atomic<std::size_t> _tail{0};
+
+            // Consumer only
+            alignas(cache_line) std::size_t _head = 0;
+
+            bool is_free(std::size_t position) const noexcept {
+                return _cells[position & _mask].sequence.load(std::memory_order_acquire) == position;
+            }
+
+        public:
+            // Capacity is rounded up to a power of two
+            explicit mpsc_queue(std::size_t capacity)
+                    : _mask(queue_capacity(capacity) - 1), _cells(new cell[_mask + 1]) {
+                for (std::size_t i = 0; i <= _mask; ++i)
+                    _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            mpsc_queue(const mpsc_queue &) = delete;
+
+            mpsc_queue &operator=(const mpsc_queue &) = delete;
+
+            std::size_t capacity() const noexcept {
+                return _mask + 1;
+            }
+
+            // Claims up to `count` consecutive positions (the consumer frees
+            // cells in order, so the last one being free means all are);
+            // returns the first and sets `count` to the number claimed, 0
+            // when the queue is full
+            std::size_t claim(std::size_t &count) noexcept {
+                std::size_t tail = _tail.load(std::memory_order_relaxed);
+                for (;;) {
+                    const std::size_t sequence = _cells[tail & _mask].sequence.load(std::memory_order_acquire);
+                    if (sequence != tail) {
+                        // Not handed back yet: full; ahead: another producer moved on
+                        if (static_cast<std::ptrdiff_t>(sequence - tail) < 0) {
+                            count = 0;
+                            return tail;
+                        }
+                        tail = _tail.load(std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    std::size_t n = count;
+                    while (n > 1 && !is_free(tail + n - 1))
+                        n /= 2;
+                    if (_tail.compare_exchange_weak(tail, tail + n, std::memory_order_relaxed)) {
+                        count = n;
+                        return tail;
+                    }
+                }
+            }
+
+            // Entry of a claimed, not yet published position
+            Entry &at(std::size_t position) noexcept {
+                return _cells[position & _mask].entry;
+            }
+
+            void publish(std::size_t position) noexcept {
+                _cells[position & _mask].sequence.store(position + 1, std::memory_order_release);
+            }
+
+            // Consumer only: the oldest entry if it is published, else null
+            Entry *front() noexcept {
+                cell &c = _cells[_head & _mask];
+                return c.sequence.load(std::memory_order_acquire) == _head + 1 ? &c.entry : nullptr;
+            }
+
+            // Consumer only: hands the cell of front() back to the producers
+            void pop() noexcept {
+                _cells[_head & _mask].sequence.store(_head + _mask + 1, std::memory_order_release);
+                ++_head;
+            }
+        };
+    }
+SMART_PTR_END_MODE
+}
+
+#endif //_SMART_PTR_MPSC_QUEUE_HPP
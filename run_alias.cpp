@@ -0,0 +1,160 @@
+#include <cassert>
+
+#include "linked_ptr.hpp"
+
+using smart_ptr::any_deleter;
+using smart_ptr::linked_ptr;
+
+struct Member
+{
+    int value = 0;
+};
+
+struct Whole
+{
+    static int alive;
+
+    int header = 0;
+    Member member;
+
+    Whole()
+    {
+        ++alive;
+    }
+
+    ~Whole()
+    {
+        --alive;
+    }
+};
+
+int Whole::alive = 0;
+
+struct Shape
+{
+    virtual ~Shape()
+    {
+    }
+};
+
+struct Circle : Shape
+{
+    static int alive;
+
+    Circle()
+    {
+        ++alive;
+    }
+
+    ~Circle()
+    {
+        --alive;
+    }
+};
+
+int Circle::alive = 0;
+
+struct Square : Shape
+{
+};
+
+static int released = 0;
+
+struct CountingDelete
+{
+    int *counter;
+
+    void operator()(Whole *whole) const
+    {
+        ++*counter;
+        delete whole;
+    }
+};
+
+int main()
+{
+    // An alias to a member keeps the whole object alive
+    {
+        linked_ptr<Whole> whole(new Whole);
+        linked_ptr<Member, any_deleter> member(whole, &whole->member);
+        linked_ptr<int, any_deleter> value(member, &member->value);
+        assert(whole.use_count() == 3 && value.get() == &whole->member.value);
+
+        whole.reset();
+        member.reset();
+        assert(Whole::alive == 1 && value.unique());
+    }
+    assert(Whole::alive == 0);
+
+    // Stateful deleters travel with the alias
+    {
+        linked_ptr<Whole, CountingDelete> whole(new Whole, CountingDelete{&released});
+        linked_ptr<Member, any_deleter> member(whole, &whole->member);
+        whole.reset();
+        assert(released == 0 && Whole::alive == 1);
+    }
+    assert(released == 1 && Whole::alive == 0);
+
+    // Assigning an owner to an alias of the same address joins the owner's
+    // ring, even though both already point at the same object
+    {
+        linked_ptr<Whole> target(new Whole);
+        linked_ptr<Whole> other(new Whole);
+        linked_ptr<Whole, any_deleter> alias(other, target.get());
+        alias = target;
+        assert(target.use_count() == 2 && other.unique());
+
+        other.reset();
+        target.reset();
+        assert(Whole::alive == 1 && alias.unique());
+        alias->header = 5;
+    }
+    assert(Whole::alive == 0);
+
+    // Empty owners give empty aliases
+    linked_ptr<Whole> none;
+    Member unowned;
+    linked_ptr<Member, any_deleter> dangling(none, &unowned);
+    assert(!dangling && !dangling.unique());
+
+    // Casts join the ring of their source
+    {
+        linked_ptr<Shape> shape(new Circle);
+        linked_ptr<Circle> circle = smart_ptr::static_pointer_cast<Circle>(shape);
+        linked_ptr<Circle> checked = smart_ptr::dynamic_pointer_cast<Circle>(shape);
+        linked_ptr<Square> wrong = smart_ptr::dynamic_pointer_cast<Square>(shape);
+        assert(circle == shape && checked == shape && !wrong && shape.use_count() == 3);
+
+        linked_ptr<const Shape> constant(shape);
+        linked_ptr<Shape> mutable_again = smart_ptr::const_pointer_cast<Shape>(constant);
+        assert(mutable_again == shape && shape.use_count() == 5);
+
+        shape.reset();
+        constant.reset();
+        mutable_again.reset();
+        checked.reset();
+        assert(Circle::alive == 1 && circle.unique());
+    }
+    assert(Circle::alive == 0);
+
+    // Casts of handles with other deleters still free through them
+    {
+        linked_ptr<Whole, CountingDelete> whole(new Whole, CountingDelete{&released});
+        linked_ptr<const Whole, any_deleter> constant = smart_ptr::static_pointer_cast<const Whole>(whole);
+        whole.reset();
+        assert(released == 1 && Whole::alive == 1 && constant.unique());
+    }
+    assert(released == 2 && Whole::alive == 0);
+
+    // Casting an alias keeps deleting the original object
+    {
+        linked_ptr<Whole> whole(new Whole);
+        linked_ptr<const Member, any_deleter> member(whole, &whole->member);
+        whole.reset();
+        linked_ptr<Member, any_deleter> writable = smart_ptr::const_pointer_cast<Member>(member);
+        member.reset();
+        writable->value = 3;
+        assert(Whole::alive == 1);
+    }
+    assert(Whole::alive == 0);
+}
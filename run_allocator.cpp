@@ -0,0 +1,83 @@
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+
+#include "linked_ptr.hpp"
+
+struct CountingResource : std::pmr::memory_resource
+{
+    std::size_t allocated = 0;
+    std::size_t deallocated = 0;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocated;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        ++deallocated;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+struct Base
+{
+    virtual ~Base()
+    {
+    }
+};
+
+struct Derived : Base
+{
+    explicit Derived(int value)
+        : value(value)
+    {
+    }
+
+    int value;
+};
+
+int main()
+{
+    CountingResource resource;
+    {
+        smart_ptr::pmr::linked_ptr<Derived> d = smart_ptr::pmr::allocate_linked<Derived>(&resource, 42);
+        assert(d->value == 42);
+        assert(resource.allocated == 1);
+
+        smart_ptr::linked_ptr<Base, smart_ptr::allocator_delete<std::pmr::polymorphic_allocator<Derived>>> b(d);
+        d.reset();
+        assert(resource.deallocated == 0);
+        assert(b.unique());
+    }
+    assert(resource.allocated == 1 && resource.deallocated == 1);
+
+    // A whole graph can live in one arena and be released at once
+    {
+        std::pmr::monotonic_buffer_resource arena(&resource);
+        std::pmr::polymorphic_allocator<int> alloc(&arena);
+
+        auto p1 = smart_ptr::allocate_linked<int>(alloc, 1);
+        auto p2 = smart_ptr::allocate_linked<int>(alloc, 2);
+        auto p3 = p1;
+        p1 = p2;
+        assert(*p3 == 1 && *p1 == 2 && p1 == p2);
+        assert(p3.get_deleter().get_allocator().resource() == &arena);
+    }
+    assert(resource.allocated == resource.deallocated);
+
+    // Adopting with std::allocator behaves like new/delete
+    std::allocator<int> alloc;
+    int *raw = std::allocator_traits<std::allocator<int>>::allocate(alloc, 1);
+    smart_ptr::linked_ptr<int, smart_ptr::allocator_delete<std::allocator<int>>> p(
+            raw, smart_ptr::allocator_delete<std::allocator<int>>(alloc));
+    assert(p.unique());
+}
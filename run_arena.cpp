@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "linked_arena.hpp"
+
+struct Obj
+{
+    static int alive;
+
+    explicit Obj(int value)
+        : value(value)
+    {
+        ++alive;
+    }
+
+    ~Obj()
+    {
+        --alive;
+    }
+
+    int value;
+};
+
+int Obj::alive = 0;
+
+using ptr_t = smart_ptr::arena_linked_ptr<Obj>;
+
+// Released after main() returns, when other statics are being destroyed
+static ptr_t survivor;
+
+int main()
+{
+    static_assert(sizeof(ptr_t) == 4, "arena handle should be one index");
+    static_assert(std::is_nothrow_move_constructible_v<ptr_t> && std::is_nothrow_move_assignable_v<ptr_t>,
+                  "containers should relocate handles by moving");
+
+    auto &arena = smart_ptr::linked_arena<Obj>::instance();
+    {
+        ptr_t p0;
+        ptr_t p1(new Obj(1));
+        assert(!p0 && !p0.unique());
+        assert(p1.unique() && p1->value == 1);
+        assert(arena.live() == 1);
+
+        ptr_t p2(p1);
+        ptr_t p3(p2);
+        assert(!p1.unique() && p1 == p3);
+        assert(arena.live() == 3);
+
+        p2.reset(new Obj(2));
+        assert(p2.unique() && Obj::alive == 2);
+
+        p1.swap(p2);
+        assert(p1->value == 2 && p2 == p3 && !p3.unique());
+
+        p3 = p0;
+        assert(p2.unique() && !p3);
+        p2 = p3;
+        assert(Obj::alive == 1 && arena.live() == 1);
+    }
+    assert(Obj::alive == 0 && arena.live() == 0);
+
+    // Freed nodes are reused instead of growing the table
+    std::size_t capacity = arena.capacity();
+    {
+        std::vector<ptr_t> handles(1000, ptr_t(new Obj(3)));
+        assert(Obj::alive == 1 && !handles.front().unique());
+        handles.resize(1);
+        assert(handles.front().unique());
+    }
+    assert(Obj::alive == 0 && arena.live() == 0);
+    {
+        std::vector<ptr_t> handles(1000, ptr_t(new Obj(4)));
+    }
+    assert(arena.capacity() == std::max<std::size_t>(capacity, 1001));
+
+    // Moves hand the node over; vector growth acquires no extra nodes
+    using moved_t = smart_ptr::arena_linked_ptr<Obj, struct MovedTag>;
+    auto &moved_arena = smart_ptr::linked_arena<Obj, MovedTag>::instance();
+    {
+        moved_t m1(new Obj(6));
+        moved_t m2(std::move(m1));
+        assert(!m1 && m2.unique() && moved_arena.live() == 1);
+
+        moved_t m3(m2);
+        m1 = std::move(m3);
+        assert(!m3 && m1 == m2 && moved_arena.live() == 2);
+        m2 = std::move(m2);
+        assert(m2 && !m2.unique());
+        m2 = moved_t(new Obj(7));
+        assert(m1.unique() && m2.unique() && Obj::alive == 2);
+
+        std::vector<moved_t> handles;
+        for (int i = 0; i < 1000; ++i)
+            handles.push_back(m1);
+        assert(moved_arena.live() == 1002 && moved_arena.capacity() == 1002);
+    }
+    assert(Obj::alive == 0 && moved_arena.live() == 0);
+
+    survivor.reset(new Obj(5));
+}
@@ -0,0 +1,91 @@
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "linked_ptr.hpp"
+
+using smart_ptr::linked_ptr;
+
+struct Element
+{
+    static int alive;
+
+    int value;
+
+    Element() : value(7)
+    {
+        ++alive;
+    }
+
+    ~Element()
+    {
+        --alive;
+    }
+};
+
+int Element::alive = 0;
+
+struct Base
+{
+};
+
+struct Derived : Base
+{
+};
+
+static_assert(sizeof(linked_ptr<int[]>) == 4 * sizeof(void *), "array size is stored once per owner");
+static_assert(sizeof(linked_ptr<int>) == 3 * sizeof(void *), "single objects store no size");
+static_assert(!std::is_constructible_v<linked_ptr<int[]>, linked_ptr<int>>, "array from single object");
+static_assert(!std::is_constructible_v<linked_ptr<int>, linked_ptr<int[]>>, "single object from array");
+static_assert(!std::is_constructible_v<linked_ptr<Base[]>, Derived *>, "derived elements have another stride");
+static_assert(std::is_constructible_v<linked_ptr<const int[]>, linked_ptr<int[]>>, "adding const");
+
+int main()
+{
+    linked_ptr<int[]> a = smart_ptr::make_linked_array<int>(8);
+    assert(a.size() == 8 && a.unique());
+    for (int value : a)
+        assert(value == 0);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+        a[i] = static_cast<int>(i);
+
+    // Owners share the elements and the size
+    linked_ptr<int[]> b(a);
+    linked_ptr<const int[]> c(b);
+    assert(b.size() == 8 && c.size() == 8 && c[5] == 5 && a.use_count() == 3);
+
+    linked_ptr<int[]> d(std::move(b));
+    assert(!b && b.size() == 0 && d.size() == 8);
+
+    linked_ptr<int[]> e(new int[3](), 3);
+    e.swap(d);
+    assert(e.size() == 8 && d.size() == 3 && e[7] == 7);
+
+    // Every element is destroyed by delete[] once the last owner goes
+    {
+        linked_ptr<Element[]> x = smart_ptr::make_linked_array_for_overwrite<Element>(4);
+        linked_ptr<Element[]> y(x);
+        x.reset();
+        assert(Element::alive == 4 && y[3].value == 7);
+    }
+    assert(Element::alive == 0);
+
+    {
+        linked_ptr<Element[], smart_ptr::any_deleter> x(new Element[2], 2);
+        x.reset(new Element[5], 5);
+        assert(Element::alive == 5 && x.size() == 5);
+    }
+    assert(Element::alive == 0);
+
+    // Transfers with unique_ptr<T[]> keep delete[]; the size is not known
+    std::unique_ptr<Element[]> u(new Element[3]);
+    linked_ptr<Element[]> f(std::move(u));
+    assert(f.size() == 0 && Element::alive == 3);
+
+    u = f.release_unique();
+    assert(!f && u && Element::alive == 3);
+    u.reset();
+    assert(Element::alive == 0);
+}
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "atomic_linked_ptr.hpp"
+
+using smart_ptr::atomic_linked_ptr;
+using smart_ptr::linked_ptr;
+
+struct Config
+{
+    static std::atomic<int> alive;
+
+    int version;
+    int check;
+
+    explicit Config(int version) : version(version), check(-version)
+    {
+        ++alive;
+    }
+
+    ~Config()
+    {
+        check = 0;
+        --alive;
+    }
+};
+
+std::atomic<int> Config::alive{0};
+
+int main()
+{
+    // Sequential semantics
+    {
+        linked_ptr<Config> first(new Config(1));
+        atomic_linked_ptr<Config> slot(first);
+        assert(first.use_count() == 2);
+
+        linked_ptr<Config> loaded = slot.load();
+        assert(loaded == first && first.use_count() == 3);
+
+        linked_ptr<Config> old = slot.exchange(linked_ptr<Config>(new Config(2)));
+        assert(old == first && first.use_count() == 3 && slot.load()->version == 2);
+
+        linked_ptr<Config> expected = first;
+        assert(!slot.compare_exchange_strong(expected, linked_ptr<Config>(new Config(3))));
+        assert(expected->version == 2 && Config::alive == 2);
+
+        assert(slot.compare_exchange_strong(expected, first));
+        assert(Config::alive == 2 && expected.unique() && slot.load() == first);
+        expected.reset();
+
+        slot.store(linked_ptr<Config>());
+        assert(!slot.load() && Config::alive == 1 && first.use_count() == 3);
+    }
+    assert(Config::alive == 0);
+
+    // Readers, writers and copies racing on one slot
+    {
+        atomic_linked_ptr<Config> slot(linked_ptr<Config>(new Config(0)));
+        std::atomic<int> next{1};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&slot, &next, t] {
+                std::vector<linked_ptr<Config>> kept;
+                for (int i = 0; i < 20000; ++i) {
+                    linked_ptr<Config> current = slot.load();
+                    assert(current && current->check == -current->version);
+
+                    if (i % 64 == t) {
+                        slot.store(linked_ptr<Config>(new Config(next++)));
+                    } else if (i % 64 == t + 8) {
+                        linked_ptr<Config> replacement(new Config(next++));
+                        while (!slot.compare_exchange_weak(current, replacement)) {}
+                    }
+
+                    kept.push_back(current);
+                    if (kept.size() == 16)
+                        kept.clear();
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        assert(Config::alive >= 1 && slot.load().use_count() == 2);
+    }
+    assert(Config::alive == 0);
+
+    // Copies and destruction of one ring on several threads
+    {
+        linked_ptr<Config> root(new Config(1));
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&root] {
+                for (int i = 0; i < 20000; ++i) {
+                    linked_ptr<Config> copy(root);
+                    linked_ptr<Config> second(copy);
+                    linked_ptr<Config> moved(std::move(copy));
+                    assert(second->check == -1 && moved == root);
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        assert(root.unique() && Config::alive == 1);
+    }
+    assert(Config::alive == 0);
+}
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "biased_linked_ptr.hpp"
+
+using smart_ptr::biased_linked_ptr;
+
+struct Config
+{
+    static std::atomic<int> alive;
+
+    int value = 7;
+
+    Config()
+    {
+        ++alive;
+    }
+
+    ~Config()
+    {
+        --alive;
+    }
+};
+
+std::atomic<int> Config::alive{0};
+
+int main()
+{
+    // Copies on one thread share its sub-ring
+    {
+        biased_linked_ptr<Config> config(new Config);
+        std::vector<biased_linked_ptr<Config>> copies(100, config);
+        assert(config.subring_count() == 1 && !config.unique());
+
+        biased_linked_ptr<Config> moved(std::move(copies.back()));
+        assert(!copies.back() && moved == config);
+        copies.clear();
+        moved.reset();
+        assert(config.unique() && Config::alive == 1);
+    }
+    assert(Config::alive == 0);
+
+    // Every thread copying a handle adds one sub-ring for all its copies
+    {
+        biased_linked_ptr<Config> config(new Config);
+        std::atomic<int> started{0};
+        std::atomic<bool> done{false};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&] {
+                biased_linked_ptr<Config> local(config);
+                std::vector<biased_linked_ptr<Config>> copies;
+                for (int i = 0; i < 1000; ++i)
+                    copies.push_back(local);
+                ++started;
+                while (!done)
+                    std::this_thread::yield();
+                for (const auto &copy : copies)
+                    assert(copy->value == 7);
+            });
+        }
+        while (started != 4)
+            std::this_thread::yield();
+        assert(config.subring_count() == 5);
+        done = true;
+        for (auto &worker : workers)
+            worker.join();
+        assert(config.unique());
+    }
+    assert(Config::alive == 0);
+
+    // Handed-off handles may be released by another thread, even last
+    {
+        std::vector<biased_linked_ptr<Config>> outgoing;
+        {
+            biased_linked_ptr<Config> config(new Config);
+            biased_linked_ptr<Config> sibling(config);
+            for (int t = 0; t < 4; ++t)
+                outgoing.push_back(config.handoff());
+            assert(config.subring_count() == 5);
+        }
+        assert(Config::alive == 1 && outgoing.front().subring_count() == 4);
+
+        std::vector<std::thread> workers;
+        for (auto &handle : outgoing) {
+            workers.emplace_back([received = std::move(handle)]() mutable {
+                biased_linked_ptr<Config> local(received);
+                biased_linked_ptr<Config> again(local);
+                received.reset();
+                assert(again->value == 7);
+            });
+        }
+        for (auto &worker : workers)
+            worker.join();
+    }
+    assert(Config::alive == 0);
+
+    // Moving a handle bound to another thread copies it
+    {
+        biased_linked_ptr<Config> config(new Config);
+        biased_linked_ptr<Config> sibling(config);
+        std::thread([&config] {
+            biased_linked_ptr<Config> taken(std::move(config));
+            assert(config && taken == config && config.subring_count() == 2);
+        }).join();
+        assert(config.subring_count() == 1 && !config.unique());
+    }
+    assert(Config::alive == 0);
+}
@@ -0,0 +1,94 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "linked_ptr_bulk.hpp"
+
+using smart_ptr::linked_ptr;
+
+static bool bit(const std::vector<std::uint64_t> &mask, std::size_t i)
+{
+    return (mask[i / 64] >> (i % 64)) & 1;
+}
+
+int main()
+{
+#if defined(__AVX2__)
+    // RBULKAVX2 build of this test; nothing to check on CPUs without AVX2
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        std::printf("AVX2 not supported by this CPU, skipped\n");
+        return 0;
+    }
+#endif
+
+    // Mix of null, unique and shared handles, with an odd length for the tails
+    std::vector<linked_ptr<int>> ptrs(203);
+    for (std::size_t i = 0; i < ptrs.size(); ++i)
+    {
+        if (i % 3 == 1)
+            ptrs[i].reset(new int(static_cast<int>(i)));
+        else if (i % 3 == 2 && i % 5)
+            ptrs[i] = ptrs[i - 1];
+    }
+
+    const std::size_t n = ptrs.size();
+    std::vector<std::uint64_t> mask((n + 63) / 64);
+    const int *key = ptrs[100].get();
+
+    smart_ptr::bulk::null_mask(ptrs.data(), n, mask.data());
+    for (std::size_t i = 0; i < n; ++i)
+        assert(bit(mask, i) == !ptrs[i]);
+
+    smart_ptr::bulk::unique_mask(ptrs.data(), n, mask.data());
+    for (std::size_t i = 0; i < n; ++i)
+        assert(bit(mask, i) == ptrs[i].unique());
+    assert(smart_ptr::bulk::popcount(mask.data(), n) > 0);
+
+    smart_ptr::bulk::equal_mask(ptrs.data(), n, key, mask.data());
+    for (std::size_t i = 0; i < n; ++i)
+        assert(bit(mask, i) == (ptrs[i].get() == key));
+    assert(smart_ptr::bulk::popcount(mask.data(), n) == 2);
+
+    smart_ptr::bulk::less_mask(ptrs.data(), n, key, mask.data());
+    for (std::size_t i = 0; i < n; ++i)
+        assert(bit(mask, i) == (ptrs[i].get() < key));
+
+    std::vector<int *> raw(n);
+    smart_ptr::bulk::gather(ptrs.data(), n, raw.data());
+    for (std::size_t i = 0; i < n; ++i)
+        assert(raw[i] == ptrs[i].get());
+
+    smart_ptr::bulk::null_mask(ptrs.data(), 0, mask.data());
+
+    // Array handles: keys and gathered pointers are element pointers
+    std::vector<linked_ptr<int[]>> arrays(9);
+    for (std::size_t i = 0; i < arrays.size(); ++i)
+    {
+        if (i % 3 == 1)
+            arrays[i].reset(new int[2], 2);
+        else if (i % 3 == 2)
+            arrays[i] = arrays[i - 1];
+    }
+
+    const std::size_t m = arrays.size();
+    const int *first = arrays[4].get();
+    smart_ptr::bulk::null_mask(arrays.data(), m, mask.data());
+    for (std::size_t i = 0; i < m; ++i)
+        assert(bit(mask, i) == !arrays[i]);
+
+    smart_ptr::bulk::unique_mask(arrays.data(), m, mask.data());
+    assert(smart_ptr::bulk::popcount(mask.data(), m) == 0);
+
+    smart_ptr::bulk::equal_mask(arrays.data(), m, first, mask.data());
+    assert(bit(mask, 4) && bit(mask, 5) && smart_ptr::bulk::popcount(mask.data(), m) == 2);
+
+    smart_ptr::bulk::less_mask(arrays.data(), m, first, mask.data());
+    for (std::size_t i = 0; i < m; ++i)
+        assert(bit(mask, i) == (arrays[i].get() < first));
+
+    smart_ptr::bulk::gather(arrays.data(), m, raw.data());
+    for (std::size_t i = 0; i < m; ++i)
+        assert(raw[i] == arrays[i].get());
+}
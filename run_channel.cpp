@@ -0,0 +1,129 @@
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "linked_channel.hpp"
+
+using smart_ptr::linked_ptr;
+using smart_ptr::mpsc_channel;
+using smart_ptr::spsc_channel;
+
+struct Item
+{
+    static std::atomic<int> alive;
+
+    int producer;
+    int sequence;
+
+    Item(int producer, int sequence) : producer(producer), sequence(sequence)
+    {
+        ++alive;
+    }
+
+    ~Item()
+    {
+        --alive;
+    }
+};
+
+std::atomic<int> Item::alive{0};
+
+int main()
+{
+    // Sequential behaviour: bounded, FIFO, handles moved not copied
+    {
+        spsc_channel<Item> channel(3);
+        assert(channel.capacity() == 4);
+
+        linked_ptr<Item> shared(new Item(0, 0));
+        linked_ptr<Item> sender(shared);
+        assert(channel.push(std::move(sender)) && !sender && shared.use_count() == 2);
+
+        std::vector<linked_ptr<Item>> batch;
+        for (int i = 1; i <= 4; ++i)
+            batch.emplace_back(new Item(0, i));
+        assert(channel.push(batch.data(), batch.size()) == 3 && batch[3]);
+        assert(!channel.push(std::move(batch[3])) && batch[3]);
+
+        linked_ptr<Item> received;
+        assert(channel.pop(received) && received == shared && shared.use_count() == 2);
+
+        linked_ptr<Item> out[8];
+        assert(channel.pop(out, 8) == 3 && out[0]->sequence == 1 && out[2]->sequence == 3);
+        assert(!channel.pop(received) && received);
+    }
+    assert(Item::alive == 0);
+
+    // A pipeline: the producer's objects are deleted by the consumer
+    {
+        spsc_channel<Item> channel(64);
+        const int count = 100000;
+        std::thread producer([&channel] {
+            linked_ptr<Item> batch[16];
+            for (int i = 0; i < count;) {
+                int n = 0;
+                for (; n < 16 && i + n < count; ++n)
+                    batch[n].reset(new Item(0, i + n));
+                for (int sent = 0; sent < n; std::this_thread::yield())
+                    sent += static_cast<int>(channel.push(batch + sent, n - sent));
+                i += n;
+            }
+        });
+
+        linked_ptr<Item> batch[8];
+        for (int expected = 0; expected < count;) {
+            std::size_t n = channel.pop(batch, 8);
+            if (!n)
+                std::this_thread::yield();
+            for (std::size_t i = 0; i < n; ++i, ++expected) {
+                assert(batch[i]->sequence == expected && batch[i].unique());
+                batch[i].reset();
+            }
+        }
+        producer.join();
+    }
+    assert(Item::alive == 0);
+
+    // Several producers, one consumer, per-producer order kept
+    {
+        mpsc_channel<Item> channel(32);
+        const int producers = 4, count = 20000;
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&channel, p] {
+                for (int i = 0; i < count; i += 4) {
+                    linked_ptr<Item> batch[4];
+                    for (int j = 0; j < 4; ++j)
+                        batch[j].reset(new Item(p, i + j));
+                    if (i % 8) {
+                        for (std::size_t sent = 0; sent < 4; std::this_thread::yield())
+                            sent += channel.push(batch + sent, 4 - sent);
+                    } else {
+                        for (auto &item : batch)
+                            while (!channel.push(std::move(item)))
+                                std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<int> next(producers, 0);
+        linked_ptr<Item> batch[8];
+        for (int received = 0; received < producers * count;) {
+            std::size_t n = channel.pop(batch, 8);
+            if (!n)
+                std::this_thread::yield();
+            for (std::size_t i = 0; i < n; ++i, ++received) {
+                assert(batch[i]->sequence == next[batch[i]->producer]++);
+                batch[i].reset();
+            }
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        linked_ptr<Item> item;
+        assert(!channel.pop(item));
+    }
+    assert(Item::alive == 0);
+}
@@ -0,0 +1,133 @@
+#include <cassert>
+
+#include "linked_ptr.hpp"
+
+using smart_ptr::linked_ptr;
+
+// C-style API with an opaque handle type
+struct handle;
+
+static int open_handles = 0;
+
+static handle *handle_open()
+{
+    ++open_handles;
+    return reinterpret_cast<handle *>(new int(0));
+}
+
+static void handle_close(handle *h)
+{
+    --open_handles;
+    delete reinterpret_cast<int *>(h);
+}
+
+struct HandleClose
+{
+    void operator()(handle *h) const
+    {
+        handle_close(h);
+    }
+};
+
+// Stateful deleter returning objects to a pool
+struct Pool
+{
+    int returned = 0;
+};
+
+struct PoolDelete
+{
+    Pool *pool = nullptr;
+
+    void operator()(int *ptr) const
+    {
+        ++pool->returned;
+        delete ptr;
+    }
+};
+
+// No virtual destructor: only deleting as Derived is correct
+struct Base
+{
+    int base = 0;
+};
+
+struct Derived : Base
+{
+    static int alive;
+
+    Derived()
+    {
+        ++alive;
+    }
+
+    ~Derived()
+    {
+        --alive;
+    }
+};
+
+int Derived::alive = 0;
+
+static int freed = 0;
+
+static void free_int(int *ptr)
+{
+    ++freed;
+    delete ptr;
+}
+
+int main()
+{
+    // Empty deleters add no bytes
+    static_assert(sizeof(linked_ptr<int>) == 3 * sizeof(void *), "default deleter takes space");
+    static_assert(sizeof(linked_ptr<handle, HandleClose>) == 3 * sizeof(void *), "empty deleter takes space");
+    static_assert(sizeof(linked_ptr<int, PoolDelete>) == 4 * sizeof(void *), "unexpected stateful layout");
+
+    {
+        linked_ptr<handle, HandleClose> h1(handle_open(), HandleClose());
+        linked_ptr<handle, HandleClose> h2(h1);
+        h1.reset();
+        assert(open_handles == 1);
+    }
+    assert(open_handles == 0);
+
+    Pool pool;
+    {
+        linked_ptr<int, PoolDelete> p1(new int(1), PoolDelete{&pool});
+        linked_ptr<int, PoolDelete> p2(p1);
+        p1.reset(new int(2), PoolDelete{&pool});
+        assert(pool.returned == 0 && p2.get_deleter().pool == &pool);
+    }
+    assert(pool.returned == 2);
+
+    {
+        linked_ptr<int, void (*)(int *)> f(new int(3), &free_int);
+        linked_ptr<int, void (*)(int *)> f2(f);
+    }
+    assert(freed == 1);
+
+    // Type-erased deleters selected at run time
+    {
+        linked_ptr<handle, smart_ptr::any_deleter> a(handle_open(), smart_ptr::any_deleter(
+                [](void *, void *ptr) { handle_close(static_cast<handle *>(ptr)); }));
+        linked_ptr<handle, smart_ptr::any_deleter> a2(a);
+
+        linked_ptr<int, smart_ptr::any_deleter> b(new int(4), smart_ptr::any_deleter(
+                [](void *context, void *ptr) {
+                    ++static_cast<Pool *>(context)->returned;
+                    delete static_cast<int *>(ptr);
+                }, &pool));
+
+        linked_ptr<int, smart_ptr::any_deleter> c(linked_ptr<int>(new int(5)));
+        c = b;
+        assert(open_handles == 1 && pool.returned == 2);
+
+        // Adopted raw pointers are deleted through their original type
+        linked_ptr<Base, smart_ptr::any_deleter> d(new Derived);
+        linked_ptr<Base, smart_ptr::any_deleter> d2(linked_ptr<Derived>(new Derived));
+        d.reset(new Derived);
+        assert(Derived::alive == 2);
+    }
+    assert(open_handles == 0 && pool.returned == 3 && Derived::alive == 0);
+}
@@ -0,0 +1,133 @@
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "linked_epoch.hpp"
+
+using smart_ptr::epoch_delete;
+using smart_ptr::epoch_domain;
+using smart_ptr::epoch_guard;
+using smart_ptr::linked_ptr;
+
+struct Node
+{
+    static std::atomic<int> alive;
+
+    int key;
+    int check;
+    std::atomic<Node *> next_raw{nullptr};
+    linked_ptr<Node, epoch_delete> next;
+
+    explicit Node(int key) : key(key), check(-key)
+    {
+        ++alive;
+    }
+
+    ~Node()
+    {
+        check = 1;
+        --alive;
+    }
+};
+
+std::atomic<int> Node::alive{0};
+
+int main()
+{
+    // Scalar-only: linked_ptr<T[], epoch_delete> does not compile
+    static_assert(smart_ptr::details::is_single_object_v<epoch_delete>, "epoch_delete must reject arrays");
+
+    // A pinned reader holds back everything retired meanwhile
+    {
+        epoch_domain domain(1);
+        epoch_domain::reader reader(domain);
+        {
+            epoch_guard guard = reader.pin();
+            linked_ptr<Node, epoch_delete> node(new Node(1), epoch_delete(domain));
+            linked_ptr<Node, epoch_delete> copy(node);
+            node.reset();
+            assert(Node::alive == 1 && domain.pending() == 0);
+
+            copy.reset();
+            for (int i = 0; i < 4; ++i)
+                domain.collect();
+            assert(Node::alive == 1 && domain.pending() == 1);
+        }
+        domain.collect();
+        domain.collect();
+        assert(Node::alive == 0 && domain.reclaimed() == 1);
+
+        // Retired objects left over go with the domain
+        linked_ptr<Node, epoch_delete>(new Node(2), epoch_delete(domain));
+        reader.enter();
+        reader.leave();
+    }
+    assert(Node::alive == 0);
+
+    // Retiring into a full queue waits out a grace period and destroys inline
+    {
+        epoch_domain domain(64, 2);
+        for (int i = 0; i < 4; ++i)
+            linked_ptr<Node, epoch_delete>(new Node(i + 1), epoch_delete(domain));
+        assert(Node::alive == 2 && domain.pending() == 2 && domain.epoch() >= 2);
+
+        while (domain.pending())
+            domain.collect();
+        assert(Node::alive == 0 && domain.reclaimed() == 2);
+    }
+
+    // Readers walk a list through raw links while a writer replaces nodes
+    {
+        epoch_domain domain;
+        Node head(0);
+        {
+            Node *tail = &head;
+            for (int key = 1; key <= 32; ++key) {
+                tail->next = linked_ptr<Node, epoch_delete>(new Node(key), epoch_delete(domain));
+                tail->next_raw.store(tail->next.get(), std::memory_order_release);
+                tail = tail->next.get();
+            }
+        }
+
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&domain, &head, &done] {
+                epoch_domain::reader reader(domain);
+                while (!done.load(std::memory_order_relaxed)) {
+                    epoch_guard guard = reader.pin();
+                    int length = 0;
+                    for (Node *node = head.next_raw.load(std::memory_order_acquire); node;
+                         node = node->next_raw.load(std::memory_order_acquire), ++length)
+                        assert(node->check == -node->key);
+                    assert(length == 32);
+                }
+            });
+        }
+
+        for (int round = 0; round < 20000; ++round) {
+            Node *prev = &head;
+            for (int i = round % 32; i > 0; --i)
+                prev = prev->next.get();
+            Node *old = prev->next.get();
+
+            linked_ptr<Node, epoch_delete> fresh(new Node(old->key), epoch_delete(domain));
+            fresh->next = old->next;
+            fresh->next_raw.store(old->next_raw.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            prev->next_raw.store(fresh.get(), std::memory_order_release);
+            prev->next = fresh;
+        }
+        done = true;
+        for (auto &reader : readers)
+            reader.join();
+
+        // Retired nodes keep their successors until they go themselves
+        while (domain.pending())
+            domain.collect();
+        assert(Node::alive == 33 && domain.reclaimed() == 20000);
+
+        head.next.reset();
+    }
+    assert(Node::alive == 0);
+}
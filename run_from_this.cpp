@@ -0,0 +1,89 @@
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "linked_ptr.hpp"
+
+using smart_ptr::linked_ptr;
+
+struct Node : smart_ptr::enable_linked_from_this<Node>
+{
+    static int alive;
+
+    std::vector<linked_ptr<Node>> *callbacks = nullptr;
+
+    Node()
+    {
+        ++alive;
+    }
+
+    Node(const Node &node) : enable_linked_from_this(node)
+    {
+        ++alive;
+    }
+
+    virtual ~Node()
+    {
+        --alive;
+    }
+
+    // Hands an owner of itself to a registry
+    void subscribe(std::vector<linked_ptr<Node>> &registry)
+    {
+        registry.push_back(linked_from_this());
+    }
+};
+
+int Node::alive = 0;
+
+struct Leaf : Node
+{
+};
+
+struct Pooled : smart_ptr::enable_linked_from_this<Pooled, smart_ptr::any_deleter>
+{
+};
+
+int main()
+{
+    std::vector<linked_ptr<Node>> registry;
+    {
+        linked_ptr<Node> a = smart_ptr::make_linked<Node>();
+        a->subscribe(registry);
+        a->subscribe(registry);
+        assert(registry.size() == 2 && registry[0] == a && a.use_count() == 3);
+    }
+    assert(Node::alive == 1);
+    registry.clear();
+    assert(Node::alive == 0);
+
+    // Adoption through a derived type, reset and unique_ptr binds the anchor
+    linked_ptr<Leaf> leaf(new Leaf);
+    assert(leaf->linked_from_this() == leaf);
+    assert(leaf.unique());
+
+    linked_ptr<Node> node;
+    node.reset(new Leaf);
+    assert(node->linked_from_this() == node);
+
+    node = std::unique_ptr<Node>(new Node);
+    linked_ptr<Node> same = node->linked_from_this();
+    assert(same == node && Node::alive == 2);
+    same.reset();
+    node.reset();
+    assert(Node::alive == 1);
+
+    // Objects without an owner have nothing to share
+    Node local;
+    assert(!local.linked_from_this() && local.weak_from_this().expired());
+
+    // Copies of an owned object are not owned
+    Node copy(*leaf);
+    assert(!copy.linked_from_this());
+
+    leaf.reset();
+    assert(Node::alive == 2);
+
+    linked_ptr<Pooled, smart_ptr::any_deleter> pooled(new Pooled);
+    assert(pooled->linked_from_this() == pooled);
+}
@@ -0,0 +1,82 @@
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "linked_ptr.hpp"
+
+struct Base
+{
+    virtual ~Base()
+    {
+    }
+};
+
+struct Derived : Base
+{
+};
+
+using smart_ptr::linked_ptr;
+
+struct Node
+{
+    int value;
+    linked_ptr<Node> next;
+};
+
+static linked_ptr<Derived> make_derived()
+{
+    linked_ptr<Derived> d(new Derived);
+    return d;
+}
+
+int main()
+{
+    // Moving a middle member leaves the ring intact
+    linked_ptr<int> p1(new int(1));
+    linked_ptr<int> p2(p1);
+    linked_ptr<int> p3(p2);
+
+    linked_ptr<int> m(std::move(p2));
+    assert(!p2 && !p2.unique() && m == p1);
+    p1.reset();
+    p3.reset();
+    assert(m.unique());
+
+    // Converting move from a derived handle
+    linked_ptr<Derived> d = make_derived();
+    linked_ptr<Derived> d2(d);
+    linked_ptr<Base> b(std::move(d));
+    assert(!d && b == d2 && !b.unique());
+    d2.reset();
+    assert(b.unique());
+
+    // Move assignment releases the old object and takes the new position
+    linked_ptr<int> q1(new int(2));
+    linked_ptr<int> q2(q1);
+    m = std::move(q1);
+    assert(!q1 && m == q2 && *m == 2 && !m.unique());
+    q2 = std::move(m);
+    assert(!m && q2.unique());
+
+    m = std::move(m);
+    b = linked_ptr<Derived>(new Derived);
+    assert(b.unique());
+
+    // Popping the front of a list: the old head owns the source
+    linked_ptr<Node> head(new Node{1, linked_ptr<Node>(new Node{2, linked_ptr<Node>(new Node{3, {}})})});
+    head = std::move(head->next);
+    assert(head && head->value == 2 && head.unique());
+    head = std::move(head->next);
+    assert(head->value == 3 && !head->next);
+    head = std::move(head->next);
+    assert(!head);
+
+    // Vector growth relocates members without breaking their rings
+    std::vector<linked_ptr<int>> ptrs;
+    linked_ptr<int> outside(new int(3));
+    for (int i = 0; i < 100; ++i)
+        ptrs.push_back(outside);
+    outside.reset();
+    ptrs.erase(ptrs.begin(), ptrs.begin() + 99);
+    assert(ptrs.front().unique() && *ptrs.front() == 3);
+}
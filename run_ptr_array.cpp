@@ -0,0 +1,73 @@
+#include <cassert>
+
+#include "linked_ptr_array.hpp"
+
+struct Obj
+{
+    static int alive;
+
+    explicit Obj(int value)
+        : value(value)
+    {
+        ++alive;
+    }
+
+    ~Obj()
+    {
+        --alive;
+    }
+
+    int value;
+};
+
+int Obj::alive = 0;
+
+using smart_ptr::linked_ptr;
+
+int main()
+{
+    smart_ptr::linked_ptr_array<Obj> arr;
+
+    arr.push_back(new Obj(0));
+    arr.push_back(nullptr);
+    assert(arr.size() == 2 && arr.unique(0) && !arr.unique(1));
+    assert(arr[0]->value == 0 && arr.data()[1] == nullptr);
+
+    // Copy-in joins the ring of an outside handle
+    linked_ptr<Obj> outside(new Obj(1));
+    arr.push_back(outside);
+    assert(!outside.unique() && !arr.unique(2) && arr[2] == outside.get());
+
+    arr.push_back_copy(0);
+    assert(!arr.unique(0) && !arr.unique(3) && arr[3] == arr[0]);
+
+    // Copy-out keeps the object alive after the elements go
+    linked_ptr<Obj> out = arr.share(0);
+    arr.erase(0);
+    assert(arr.size() == 3 && arr[0] == out.get());
+    arr.erase(0);
+    assert(out.unique() && Obj::alive == 2);
+    out.reset();
+    assert(Obj::alive == 1);
+
+    outside.reset();
+    assert(Obj::alive == 1 && arr.unique(0) && arr[0]->value == 1);
+
+    // Copies of the container share every object
+    {
+        smart_ptr::linked_ptr_array<Obj> copy(arr);
+        assert(!arr.unique(0) && !copy.unique(0));
+    }
+    assert(arr.unique(0));
+
+    arr.erase(0);
+    assert(Obj::alive == 0 && arr.size() == 1 && !arr[0]);
+
+    arr.push_back(new Obj(2));
+    arr.push_back_copy(1);
+    arr.pop_back();
+    assert(arr.unique(1));
+    arr.push_back_copy(1);
+    arr.clear();
+    assert(Obj::alive == 0 && arr.empty());
+}
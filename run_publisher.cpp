@@ -0,0 +1,106 @@
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "linked_publisher.hpp"
+
+using smart_ptr::epoch_delete;
+using smart_ptr::epoch_domain;
+using smart_ptr::epoch_guard;
+using smart_ptr::linked_ptr;
+using smart_ptr::linked_publisher;
+
+struct Config
+{
+    static std::atomic<int> alive;
+
+    int version;
+    int check;
+
+    explicit Config(int version) : version(version), check(-version)
+    {
+        ++alive;
+    }
+
+    ~Config()
+    {
+        check = 1;
+        --alive;
+    }
+};
+
+std::atomic<int> Config::alive{0};
+
+int main()
+{
+    epoch_domain domain;
+
+    // Snapshots keep replaced versions until they are dropped
+    {
+        linked_publisher<Config> publisher(linked_ptr<Config>(new Config(1)), domain);
+        epoch_domain::reader reader(domain);
+        {
+            auto snapshot = publisher.read(reader);
+            assert(snapshot->version == 1);
+
+            publisher.publish(linked_ptr<Config>(new Config(2)));
+            for (int i = 0; i < 4; ++i)
+                domain.collect();
+            assert(Config::alive == 2 && snapshot->check == -1);
+            assert(publisher.read(reader)->version == 2);
+        }
+        publisher.synchronize();
+        assert(Config::alive == 1);
+
+        // Versions still shared by writers outlive the grace period
+        linked_ptr<Config> kept = publisher.current();
+        publisher.publish(linked_ptr<Config>());
+        publisher.synchronize();
+        assert(Config::alive == 1 && kept.unique() && !publisher.read(reader));
+    }
+    assert(Config::alive == 0);
+
+    // synchronize() only waits for this publisher's versions, not for
+    // other objects pending in the domain behind a pinned reader
+    {
+        linked_publisher<Config> publisher(linked_ptr<Config>(new Config(1)), domain);
+        epoch_domain::reader reader(domain);
+        epoch_guard guard = reader.pin();
+        linked_ptr<Config, epoch_delete>(new Config(2), epoch_delete(domain));
+        assert(domain.pending() == 1);
+
+        publisher.synchronize();
+        assert(Config::alive == 2 && domain.pending() == 1);
+    }
+    while (domain.pending())
+        domain.collect();
+    assert(Config::alive == 0);
+
+    // Readers racing with a writer always see a live version
+    {
+        linked_publisher<Config> publisher(linked_ptr<Config>(new Config(0)), domain);
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&] {
+                epoch_domain::reader reader(domain);
+                int last = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto snapshot = publisher.read(reader);
+                    assert(snapshot->check == -snapshot->version && snapshot->version >= last);
+                    last = snapshot->version;
+                }
+            });
+        }
+        for (int version = 1; version <= 5000; ++version)
+            publisher.publish(linked_ptr<Config>(new Config(version)));
+        done = true;
+        for (auto &reader : readers)
+            reader.join();
+
+        publisher.synchronize();
+        assert(Config::alive == 1 && publisher.current()->version == 5000);
+    }
+    assert(Config::alive == 0);
+}
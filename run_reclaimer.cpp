@@ -0,0 +1,88 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "linked_reclaimer.hpp"
+
+using smart_ptr::deferred_delete;
+using smart_ptr::linked_ptr;
+using smart_ptr::linked_reclaimer;
+
+struct Heavy
+{
+    static std::atomic<int> alive;
+    static std::atomic<int> inline_destroyed;
+
+    std::thread::id owner = std::this_thread::get_id();
+
+    Heavy()
+    {
+        ++alive;
+    }
+
+    virtual ~Heavy()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (std::this_thread::get_id() == owner)
+            ++inline_destroyed;
+        --alive;
+    }
+};
+
+std::atomic<int> Heavy::alive{0};
+std::atomic<int> Heavy::inline_destroyed{0};
+
+int main()
+{
+    // Scalar-only: linked_ptr<T[], deferred_delete> does not compile
+    static_assert(smart_ptr::details::is_single_object_v<deferred_delete>, "deferred_delete must reject arrays");
+
+    {
+        linked_reclaimer reclaimer;
+        {
+            linked_ptr<Heavy, deferred_delete> a(new Heavy, deferred_delete(reclaimer));
+            linked_ptr<Heavy, deferred_delete> b(a);
+
+            // Only the last owner retires the object, without running it
+            a.reset();
+            b.reset();
+            assert(Heavy::inline_destroyed == 0);
+
+            // ... and the background thread destroys it
+            while (reclaimer.pending())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            assert(Heavy::alive == 0 && Heavy::inline_destroyed == 0 && reclaimer.reclaimed() == 1);
+        }
+
+        std::vector<linked_ptr<Heavy, deferred_delete>> batch;
+        for (int i = 0; i < 16; ++i)
+            batch.emplace_back(new Heavy, deferred_delete(reclaimer));
+        batch.clear();
+        assert(reclaimer.pending() <= 16);
+
+        reclaimer.drain();
+        assert(reclaimer.pending() == 0 && reclaimer.reclaimed() == 17 && Heavy::alive == 0);
+
+        // Objects still queued are destroyed when the reclaimer goes
+        for (int i = 0; i < 8; ++i)
+            linked_ptr<Heavy, deferred_delete>(new Heavy, deferred_delete(reclaimer));
+    }
+    assert(Heavy::alive == 0);
+
+    // A full queue makes releases destroy their objects inline
+    {
+        linked_reclaimer small(2);
+        assert(small.capacity() == 2);
+        for (int i = 0; i < 8; ++i)
+            linked_ptr<Heavy, deferred_delete>(new Heavy, deferred_delete(small));
+        small.drain();
+        assert(Heavy::alive == 0 && small.reclaimed() < 8);
+    }
+
+    // Default constructed deleters use the process-wide reclaimer
+    linked_ptr<Heavy, deferred_delete>(new Heavy);
+    linked_reclaimer::global().drain();
+    assert(Heavy::alive == 0 && linked_reclaimer::global().reclaimed() == 1);
+}
@@ -0,0 +1,85 @@
+#include <cassert>
+#include <new>
+#include <vector>
+
+#include "linked_region.hpp"
+
+using smart_ptr::linked_ptr;
+using smart_ptr::linked_region;
+using smart_ptr::linked_weak_ptr;
+using smart_ptr::region_delete;
+
+struct Node
+{
+    static int alive;
+
+    int id;
+    std::vector<linked_ptr<Node, region_delete>> edges;
+    linked_weak_ptr<Node, region_delete> parent;
+    linked_ptr<int> shared;
+
+    explicit Node(int id, linked_ptr<int> shared = linked_ptr<int>()) : id(id), shared(shared)
+    {
+        ++alive;
+    }
+
+    ~Node()
+    {
+        --alive;
+    }
+};
+
+int Node::alive = 0;
+
+int main()
+{
+    linked_ptr<int> config(new int(1));
+    {
+        linked_region region;
+        {
+            // A densely shared, cyclic graph: every node points at all
+            // earlier ones and the first one at the last
+            std::vector<linked_ptr<Node, region_delete>> nodes;
+            for (int i = 0; i < 64; ++i) {
+                linked_ptr<Node, region_delete> node = region.make<Node>(i, config);
+                for (const auto &edge : nodes) {
+                    node->edges.push_back(edge);
+                    if (!edge->parent.lock())
+                        edge->parent = node;
+                }
+                nodes.push_back(node);
+            }
+            nodes.front()->edges.push_back(nodes.back());
+        }
+        // Only the region can free the cycle
+        assert(Node::alive == 64 && config.use_count() == 65);
+
+        // Objects released before the region closes go early
+        linked_ptr<Node, region_delete> single = region.make<Node>(100);
+        single.reset();
+        assert(Node::alive == 64);
+
+        linked_weak_ptr<Node, region_delete> observer = region.make<Node>(200);
+        assert(observer.expired() && Node::alive == 64);
+    }
+    // Handles to objects outside the region were unlinked normally
+    assert(Node::alive == 0 && config.unique());
+
+    // A closed region can be reused
+    linked_region region;
+    region.make<Node>(1)->edges.push_back(region.make<Node>(2));
+    region.close();
+    assert(Node::alive == 0);
+    linked_ptr<Node, region_delete> again = region.make<Node>(3);
+    assert(Node::alive == 1);
+    again.reset();
+    assert(Node::alive == 0);
+
+#ifndef NDEBUG
+    // Handles outliving the region are reported; this one is never destroyed
+    alignas(linked_ptr<Node, region_delete>) unsigned char storage[sizeof(linked_ptr<Node, region_delete>)];
+    ::new (storage) linked_ptr<Node, region_delete>(region.make<Node>(4));
+    region.make<Node>(5)->edges.push_back(region.make<Node>(6));
+    assert(region.close() == 1 && Node::alive == 0);
+#endif
+}
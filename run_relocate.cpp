@@ -0,0 +1,86 @@
+#include <cassert>
+#include <memory>
+
+#include "linked_vector.hpp"
+
+struct Obj
+{
+    static int alive;
+
+    explicit Obj(int value)
+        : value(value)
+    {
+        ++alive;
+    }
+
+    ~Obj()
+    {
+        --alive;
+    }
+
+    int value;
+};
+
+int Obj::alive = 0;
+
+using smart_ptr::linked_ptr;
+
+int main()
+{
+    // Rings mixing members inside the vector (adjacent or not) and outside it
+    linked_ptr<Obj> outside(new Obj(0));
+    smart_ptr::linked_vector<Obj> vec;
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (i % 3 == 0)
+            vec.push_back(outside);
+        else if (i % 3 == 1)
+            vec.emplace_back(new Obj(i));
+        else
+            vec.push_back(vec.back());
+    }
+    assert(vec.size() == 1000 && vec.capacity() >= 1000);
+
+    vec.reserve(5000);
+    assert(vec.capacity() == 5000 && Obj::alive == 334);
+    for (int i = 0; i < 1000; ++i)
+        assert(vec[i].get() == (i % 3 == 0 ? outside.get() : vec[i - (i % 3 == 2)].get()));
+
+    outside.reset();
+    assert(Obj::alive == 334);
+
+    // Dropping every other member keeps the rest consistent
+    smart_ptr::linked_vector<Obj> copy(vec);
+    vec.clear();
+    assert(Obj::alive == 334);
+    for (int i = 1; i < 1000; i += 3)
+    {
+        linked_ptr<Obj> last(copy[i]);
+        copy[i].reset();
+        copy[i + 1].reset();
+        assert(last.unique());
+    }
+    copy = smart_ptr::linked_vector<Obj>();
+    assert(Obj::alive == 0);
+
+    // Arguments referring to an element survive the growth they trigger
+    {
+        smart_ptr::linked_vector<Obj> self;
+        self.emplace_back(new Obj(1));
+        while (self.size() < self.capacity())
+            self.emplace_back(self[0]);
+        self.emplace_back(self[0]);
+        assert(self.size() > self.capacity() / 2 && self.back()->value == 1 && self[0].use_count() == self.size());
+    }
+    assert(Obj::alive == 0);
+
+    // Non-trivially copyable deleters fall back to element-wise moves
+    using alloc_ptr = linked_ptr<int, smart_ptr::allocator_delete<std::allocator<int>>>;
+    smart_ptr::linked_vector<int, smart_ptr::allocator_delete<std::allocator<int>>> ints;
+    alloc_ptr first = smart_ptr::allocate_linked<int>(std::allocator<int>(), 7);
+    for (int i = 0; i < 100; ++i)
+        ints.push_back(first);
+    first.reset();
+    ints.reserve(1000);
+    assert(*ints[99] == 7);
+}
@@ -0,0 +1,193 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "atomic_linked_ptr.hpp"
+
+// Multithreaded stress of the ring operations: threads copy, move, swap,
+// reset and destroy handles of shared rings (copies made right next to
+// common roots, so neighbours are hammered from several threads) and pass
+// objects to each other through atomic slots, so last owners end up on
+// any thread. Afterwards every ring is checked against the handles that
+// should be in it, and objects are accounted like Cnt::verify_state.
+//
+// Usage: RSTRESS [operations per thread]; prints throughput per thread count.
+
+using smart_ptr::atomic_linked_ptr;
+using smart_ptr::linked_ptr;
+
+// Checked in every build, release included
+#define CHECK(cond) \
+    do { if (!(cond)) { std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); std::abort(); } } while (0)
+
+struct Tracked
+{
+    static constexpr std::uint32_t live = 0x11fe11fe;
+    static std::atomic<long> created;
+    static std::atomic<long> destroyed;
+
+    std::uint32_t state = live;
+
+    Tracked()
+    {
+        ++created;
+    }
+
+    ~Tracked()
+    {
+        CHECK(state == live);
+        state = 0;
+        ++destroyed;
+    }
+
+    static void verify_state(long alive)
+    {
+        CHECK(created - destroyed == alive);
+    }
+};
+
+std::atomic<long> Tracked::created{0};
+std::atomic<long> Tracked::destroyed{0};
+
+using handle = linked_ptr<Tracked>;
+
+static const int roots_count = 4;
+static const int slots_count = 8;
+static const int locals_count = 16;
+
+// xorshift, good enough to pick operations
+struct Random
+{
+    std::uint32_t state;
+
+    unsigned next(unsigned bound)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state % bound;
+    }
+};
+
+static void touch(const handle &h)
+{
+    if (h)
+        CHECK(h->state == Tracked::live);
+}
+
+static void hammer(std::vector<handle> &locals, const std::vector<handle> &roots,
+                   atomic_linked_ptr<Tracked> *slots, long ops, std::uint32_t seed)
+{
+    Random random{seed};
+    for (long op = 0; op < ops; ++op)
+    {
+        handle &target = locals[random.next(locals_count)];
+        handle &other = locals[random.next(locals_count)];
+        switch (random.next(10))
+        {
+        case 0:
+        case 1:
+            target = roots[random.next(roots_count)];
+            break;
+        case 2:
+            target = other;
+            break;
+        case 3:
+            target = std::move(other);
+            break;
+        case 4:
+            target.swap(other);
+            break;
+        case 5:
+            target.reset();
+            break;
+        case 6:
+            target.reset(new Tracked);
+            break;
+        case 7:
+            target = slots[random.next(slots_count)].load();
+            break;
+        case 8:
+            slots[random.next(slots_count)].store(target);
+            break;
+        default:
+        {
+            handle copy(target);
+            handle second(copy);
+            touch(second);
+            break;
+        }
+        }
+        touch(target);
+        touch(other);
+    }
+}
+
+// Every handle's use_count() must match the handles counted pointing to
+// its object, i.e. each ring holds exactly those handles
+static void verify_rings(const std::vector<handle> &roots, const std::vector<std::vector<handle>> &locals,
+                         atomic_linked_ptr<Tracked> *slots)
+{
+    std::vector<const handle *> all;
+    for (const auto &root : roots)
+        all.push_back(&root);
+    for (const auto &thread : locals)
+        for (const auto &local : thread)
+            all.push_back(&local);
+    // Each slot is one ring member; its loaded copy another
+    std::vector<handle> loaded;
+    loaded.reserve(slots_count);
+    for (int i = 0; i < slots_count; ++i)
+        loaded.push_back(slots[i].load());
+
+    std::map<const Tracked *, std::size_t> members;
+    for (const handle *h : all)
+        if (*h)
+            ++members[h->get()];
+    for (const auto &h : loaded)
+        if (h)
+            members[h.get()] += 2;
+
+    for (const handle *h : all)
+        if (*h)
+            CHECK(h->use_count() == members[h->get()]);
+    for (const auto &h : loaded)
+        if (h)
+            CHECK(h.use_count() == members[h.get()]);
+    Tracked::verify_state(static_cast<long>(members.size()));
+}
+
+int main(int argc, char **argv)
+{
+    const long ops = argc > 1 ? std::atol(argv[1]) : 20000;
+
+    std::printf("%8s %14s\n", "threads", "ops/s");
+    for (unsigned threads = 1; threads <= 8; threads *= 2)
+    {
+        {
+            std::vector<handle> roots;
+            for (int i = 0; i < roots_count; ++i)
+                roots.emplace_back(new Tracked);
+            atomic_linked_ptr<Tracked> slots[slots_count];
+            std::vector<std::vector<handle>> locals(threads, std::vector<handle>(locals_count));
+
+            std::vector<std::thread> workers;
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned t = 0; t < threads; ++t)
+                workers.emplace_back(hammer, std::ref(locals[t]), std::cref(roots), slots, ops, 2463534242u + t);
+            for (auto &worker : workers)
+                worker.join();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            verify_rings(roots, locals, slots);
+            std::printf("%8u %14.0f\n", threads, threads * ops / seconds);
+        }
+        Tracked::verify_state(0);
+    }
+}
@@ -0,0 +1,57 @@
+#include <cassert>
+#include <memory>
+#include <utility>
+
+#include "linked_ptr.hpp"
+
+struct Base
+{
+    virtual ~Base()
+    {
+    }
+};
+
+struct Derived : Base
+{
+    int value = 0;
+};
+
+using smart_ptr::linked_ptr;
+
+struct Holder
+{
+    std::unique_ptr<Holder> inner;
+};
+
+int main()
+{
+    std::unique_ptr<Derived> u(new Derived);
+    Derived *raw = u.get();
+
+    // Adoption keeps the object in place
+    linked_ptr<Derived> d(std::move(u));
+    assert(!u && d.get() == raw && d.unique());
+
+    // Collapsing back fails while other owners exist
+    linked_ptr<Base> b(d);
+    std::unique_ptr<Derived> back = d.release_unique();
+    assert(!back && d.get() == raw && b == d);
+
+    b.reset();
+    back = d.release_unique();
+    assert(back.get() == raw && !d && !d.unique());
+
+    back->value = 42;
+    linked_ptr<Base> b2;
+    b2 = std::move(back);
+    assert(!back && b2.get() == raw && b2.unique());
+
+    // Assigning a unique_ptr owned by the object being replaced
+    linked_ptr<Holder> h(new Holder{std::unique_ptr<Holder>(new Holder)});
+    Holder *inner = h->inner.get();
+    h = std::move(h->inner);
+    assert(h.get() == inner && h.unique() && !h->inner);
+
+    linked_ptr<int> empty;
+    assert(!empty.release_unique());
+}
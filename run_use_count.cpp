@@ -0,0 +1,50 @@
+#include <cassert>
+#include <vector>
+
+#include "linked_ptr.hpp"
+
+struct Base
+{
+    virtual ~Base()
+    {
+    }
+};
+
+struct Derived : Base
+{
+};
+
+int main()
+{
+    using smart_ptr::linked_ptr;
+
+    linked_ptr<int> empty;
+    assert(empty.use_count() == 0);
+
+    linked_ptr<int> p1(new int);
+    assert(p1.use_count() == 1);
+    {
+        std::vector<linked_ptr<int>> copies(10, p1);
+        assert(p1.use_count() == 11 && copies[5].use_count() == 11);
+        copies.resize(4);
+        assert(copies.back().use_count() == 5);
+    }
+    assert(p1.use_count() == 1);
+
+    // Converted handles are counted in the same ring
+    linked_ptr<Derived> d1(new Derived);
+    {
+        linked_ptr<Derived> d2(d1);
+        linked_ptr<Base> b(d2);
+        assert(d1.use_count() == 3 && b.use_count() == 3);
+
+        linked_ptr<Base> moved(std::move(b));
+        assert(moved.use_count() == 3 && b.use_count() == 0);
+
+        d2.reset(new Derived);
+        assert(d2.use_count() == 1 && d1.use_count() == 2);
+    }
+    assert(d1.use_count() == 1 && d1.unique());
+    d1.reset();
+    assert(d1.use_count() == 0);
+}
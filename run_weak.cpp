@@ -0,0 +1,111 @@
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "linked_ptr.hpp"
+#include "linked_ptr_bulk.hpp"
+#include "linked_vector.hpp"
+
+using smart_ptr::linked_ptr;
+using smart_ptr::linked_weak_ptr;
+
+struct Base
+{
+    virtual ~Base()
+    {
+    }
+};
+
+struct Derived : Base
+{
+    static int alive;
+
+    Derived()
+    {
+        ++alive;
+    }
+
+    ~Derived()
+    {
+        --alive;
+    }
+};
+
+int Derived::alive = 0;
+
+static_assert(sizeof(linked_weak_ptr<int>) == 3 * sizeof(void *), "same footprint as linked_ptr");
+
+int main()
+{
+    linked_weak_ptr<Base> empty;
+    assert(empty.expired() && !empty.lock() && empty.use_count() == 0);
+
+    linked_ptr<Derived> a(new Derived);
+    linked_weak_ptr<Base> w(a);
+    linked_weak_ptr<Derived> w2(a);
+
+    // Weak members do not count as owners
+    assert(a.unique() && a.use_count() == 1 && w.use_count() == 1 && !w.expired());
+
+    {
+        linked_ptr<Base> b = w.lock();
+        assert(b == a && !a.unique() && a.use_count() == 2 && w2.use_count() == 2);
+    }
+    assert(a.unique() && Derived::alive == 1);
+
+    // Copies and moves of observers stay in the ring
+    linked_weak_ptr<Base> w3(w2);
+    linked_weak_ptr<Base> w4(std::move(w3));
+    assert(w3.expired() && !w4.expired() && w4.lock() == a);
+
+    linked_ptr<Derived> c(a);
+    a.reset();
+    assert(Derived::alive == 1 && !w.expired() && c.unique());
+
+    // The last owner destroys the object and expires every observer
+    c.reset();
+    assert(Derived::alive == 0);
+    assert(w.expired() && w2.expired() && w4.expired() && !w.lock() && w2.use_count() == 0);
+
+    {
+        linked_ptr<Derived> d(new Derived);
+        linked_weak_ptr<Derived> wd;
+        wd = d;
+        linked_ptr<Derived> e = wd.lock();
+        std::unique_ptr<Derived> u = d.release_unique();
+        assert(!u && Derived::alive == 1);
+
+        e.reset();
+        u = d.release_unique();
+        assert(u && wd.expired() && Derived::alive == 1);
+    }
+    assert(Derived::alive == 0);
+
+    // Bulk queries see owners observed only by weak members as unique
+    std::vector<linked_ptr<int>> owners;
+    std::vector<linked_weak_ptr<int>> observers;
+    observers.reserve(16);
+    for (int i = 0; i < 16; ++i) {
+        owners.emplace_back(new int(i));
+        if (i % 3 == 0)
+            observers.emplace_back(owners.back());
+    }
+    linked_ptr<int> shared(owners[6]);
+
+    std::uint64_t mask = 0;
+    smart_ptr::bulk::unique_mask(owners.data(), owners.size(), &mask);
+    assert(mask == (0xFFFFu & ~(1u << 6)));
+
+    // Relocation repairs links of weak neighbours
+    smart_ptr::linked_vector<int> moved;
+    for (linked_ptr<int> &l_ptr : owners)
+        moved.push_back(std::move(l_ptr));
+    moved.reserve(4 * moved.capacity());
+    owners.clear();
+    assert(moved[3].unique() && observers[1].lock() == moved[3]);
+    moved.clear();
+    assert(observers[1].expired() && !observers[2].expired());
+    shared.reset();
+    assert(observers[2].expired());
+}
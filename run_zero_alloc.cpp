@@ -0,0 +1,113 @@
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <set>
+
+#include "linked_ptr.hpp"
+
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+struct Base
+{
+    virtual ~Base()
+    {
+    }
+};
+
+struct Derived : Base
+{
+    Derived() = default;
+
+    explicit Derived(int value)
+        : value(value)
+    {
+    }
+
+    int value = 0;
+};
+
+// The smoke_test scenarios themselves, run under the counter below; its
+// main() is not special inside a namespace, hence the missing return
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+namespace smoke {
+#include "smoke_test.cpp"
+}
+#pragma GCC diagnostic pop
+
+using smart_ptr::linked_ptr;
+
+int main()
+{
+    // Each smoke scenario allocates exactly the objects it hands to linked_ptr
+    std::size_t before = allocations;
+    smoke::compile_err_ctor();
+    smoke::construct_check();
+    assert(allocations == before + 1);
+    smoke::op_check();
+    assert(allocations == before + 2);
+    smoke::misc_check();
+    assert(allocations == before + 4);
+    smoke::less_check();
+    assert(allocations == before + 4);
+
+    // Null pointers, copies and conversions must not allocate
+    before = allocations;
+    {
+        linked_ptr<int> p1;
+        linked_ptr<int> p2(nullptr);
+        linked_ptr<int> p3(p1);
+        p2 = p3;
+        p1.swap(p2);
+        p3.reset();
+    }
+    assert(allocations == before);
+
+    // Owning pointers allocate only the managed objects
+    before = allocations;
+    {
+        linked_ptr<Derived> d(new Derived);
+        linked_ptr<Base> b(d);
+        linked_ptr<Derived> d2(d);
+        d2 = d;
+
+        linked_ptr<int> i1(new int(1));
+        linked_ptr<int> i2(i1);
+        i1.swap(i2);
+        i2.reset(new int(2));
+        i1.swap(i2);
+    }
+    assert(allocations == before + 3);
+
+    // make_linked costs a single allocation for the object
+    before = allocations;
+    {
+        linked_ptr<Derived> d = smart_ptr::make_linked<Derived>(7);
+        assert(allocations == before + 1);
+        assert(d.unique() && d->value == 7);
+
+        linked_ptr<Base> b(d);
+        d.reset();
+        assert(b.unique());
+    }
+    assert(allocations == before + 1);
+}